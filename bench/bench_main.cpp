@@ -0,0 +1,433 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// Macro benchmark for the four boolean operations.
+//
+// Every workload is a pair of paths built from the shapes in tests/utils.cpp, laid out on a
+// grid whose size grows from run to run so that both the number of contours and the number of
+// edges per graph increase. The second operand is offset by half a cell so every contour of
+// the first path crosses its counterpart. Two kernels are timed on the same workloads as well:
+// intersecting every edge of the first graph with every edge of the second, and testing the
+// midpoint of every edge of the second graph against the contours of the first. Those call the
+// intersection callbacks once per edge pair. Results are written to stdout as JSON.
+//
+//   bench_vectorboolean [--iterations N] [--max-grid N] [--workload NAME] [--threads N]
+
+#include "../tests/utils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <functional>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace fb;
+
+// MARK: ********** Heap accounting **********
+
+// Live and peak heap bytes, tracked by replacing the global allocation functions. The size of
+// every block is stored in a header in front of it so that unsized deletes can be accounted.
+static std::atomic<size_t> FBBenchLiveBytes{0};
+static std::atomic<size_t> FBBenchPeakBytes{0};
+static constexpr size_t FBBenchHeaderSize = alignof(std::max_align_t);
+
+static void FBBenchRecordAllocation(size_t size) {
+  size_t live = FBBenchLiveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+  size_t peak = FBBenchPeakBytes.load(std::memory_order_relaxed);
+  while (live > peak && !FBBenchPeakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+  }
+}
+
+static void *FBBenchAllocate(size_t size) {
+  void *block = std::malloc(size + FBBenchHeaderSize);
+  if (block == nullptr) {
+    throw std::bad_alloc();
+  }
+  *static_cast<size_t *>(block) = size;
+  FBBenchRecordAllocation(size);
+  return static_cast<char *>(block) + FBBenchHeaderSize;
+}
+
+static void FBBenchDeallocate(void *pointer) {
+  if (pointer == nullptr) {
+    return;
+  }
+  void *block = static_cast<char *>(pointer) - FBBenchHeaderSize;
+  FBBenchLiveBytes.fetch_sub(*static_cast<size_t *>(block), std::memory_order_relaxed);
+  std::free(block);
+}
+
+// Over-aligned blocks keep the size in a header as large as the alignment
+static void *FBBenchAllocateAligned(size_t size, std::align_val_t alignment) {
+  size_t headerSize = std::max(FBBenchHeaderSize, static_cast<size_t>(alignment));
+  size_t blockSize = (size + 2 * headerSize - 1) / headerSize * headerSize;
+#if defined(_WIN32)
+  void *block = _aligned_malloc(blockSize, headerSize);
+#else
+  void *block = std::aligned_alloc(headerSize, blockSize);
+#endif
+  if (block == nullptr) {
+    throw std::bad_alloc();
+  }
+  *static_cast<size_t *>(block) = size;
+  FBBenchRecordAllocation(size);
+  return static_cast<char *>(block) + headerSize;
+}
+
+static void FBBenchDeallocateAligned(void *pointer, std::align_val_t alignment) {
+  if (pointer == nullptr) {
+    return;
+  }
+  size_t headerSize = std::max(FBBenchHeaderSize, static_cast<size_t>(alignment));
+  void *block = static_cast<char *>(pointer) - headerSize;
+  FBBenchLiveBytes.fetch_sub(*static_cast<size_t *>(block), std::memory_order_relaxed);
+#if defined(_WIN32)
+  _aligned_free(block);
+#else
+  std::free(block);
+#endif
+}
+
+void *operator new(size_t size) { return FBBenchAllocate(size); }
+void *operator new[](size_t size) { return FBBenchAllocate(size); }
+void operator delete(void *pointer) noexcept { FBBenchDeallocate(pointer); }
+void operator delete[](void *pointer) noexcept { FBBenchDeallocate(pointer); }
+void operator delete(void *pointer, size_t) noexcept { FBBenchDeallocate(pointer); }
+void operator delete[](void *pointer, size_t) noexcept { FBBenchDeallocate(pointer); }
+void *operator new(size_t size, std::align_val_t alignment) { return FBBenchAllocateAligned(size, alignment); }
+void *operator new[](size_t size, std::align_val_t alignment) { return FBBenchAllocateAligned(size, alignment); }
+void operator delete(void *pointer, std::align_val_t alignment) noexcept {
+  FBBenchDeallocateAligned(pointer, alignment);
+}
+void operator delete[](void *pointer, std::align_val_t alignment) noexcept {
+  FBBenchDeallocateAligned(pointer, alignment);
+}
+void operator delete(void *pointer, size_t, std::align_val_t alignment) noexcept {
+  FBBenchDeallocateAligned(pointer, alignment);
+}
+void operator delete[](void *pointer, size_t, std::align_val_t alignment) noexcept {
+  FBBenchDeallocateAligned(pointer, alignment);
+}
+
+// Restart peak tracking from the bytes currently alive.
+static void FBBenchResetPeak() { FBBenchPeakBytes.store(FBBenchLiveBytes.load()); }
+
+// Peak resident set size of the whole process in kilobytes.
+static size_t FBBenchMaxResidentKilobytes() {
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return counters.PeakWorkingSetSize / 1024;
+  }
+  return 0;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#if defined(__APPLE__)
+  return usage.ru_maxrss / 1024; // bytes on macOS
+#else
+  return usage.ru_maxrss;
+#endif
+#endif
+}
+
+// MARK: ********** Workloads **********
+
+struct FBBenchWorkload {
+  std::string name;
+  size_t grid;
+  FBBezierPath path1;
+  FBBezierPath path2;
+  std::shared_ptr<FBBezierGraph> graph1;
+  std::shared_ptr<FBBezierGraph> graph2;
+};
+
+// An operation runs once over a workload and returns the number of elements it produced.
+struct FBBenchOperation {
+  const char *name;
+  size_t (*run)(const FBBenchWorkload &workload);
+};
+
+static const FBFloat FBBenchCellSize = 20.0;
+static const FBFloat FBBenchShapeSize = 12.0;
+
+// Calls block with the origin of each cell of a grid x grid layout, offset by the given amount.
+static void FBBenchForEachCell(size_t grid, FBFloat offset, std::function<void(FBPoint origin)> block) {
+  for (size_t row = 0; row < grid; row++) {
+    for (size_t column = 0; column < grid; column++) {
+      block(FBPoint{column * FBBenchCellSize + offset, row * FBBenchCellSize + offset});
+    }
+  }
+}
+
+static FBBezierPath FBBenchRectangles(size_t grid, FBFloat offset) {
+  FBBezierPath path;
+  FBBenchForEachCell(grid, offset, [&](FBPoint origin) {
+    addRectangle(path, {origin, {FBBenchShapeSize, FBBenchShapeSize}});
+  });
+  return path;
+}
+
+static FBBezierPath FBBenchCircles(size_t grid, FBFloat offset) {
+  FBBezierPath path;
+  FBBenchForEachCell(grid, offset, [&](FBPoint origin) {
+    FBFloat radius = FBBenchShapeSize / 2.0;
+    addCircle(path, {origin.x + radius, origin.y + radius}, radius);
+  });
+  return path;
+}
+
+static FBBezierPath FBBenchArcShapes(size_t grid, FBFloat offset) {
+  FBBezierPath path;
+  FBBenchForEachCell(grid, offset, [&](FBPoint origin) {
+    addArcShape(path, {origin, {FBBenchShapeSize, FBBenchShapeSize}});
+  });
+  return path;
+}
+
+// Rectangles and circles in the same path, clipped against arc shapes.
+static FBBezierPath FBBenchMixed(size_t grid, FBFloat offset) {
+  FBBezierPath path;
+  FBBenchForEachCell(grid, offset, [&](FBPoint origin) {
+    addRectangle(path, {origin, {FBBenchShapeSize, FBBenchShapeSize / 2.0}});
+    FBFloat radius = FBBenchShapeSize / 4.0;
+    addCircle(path, {origin.x + radius, origin.y + FBBenchShapeSize - radius}, radius);
+  });
+  return path;
+}
+
+// One long thin rectangle per row of the grid, like hatch lines. Clipped against circles each of
+//  its long edges crosses every circle in its row, so the edges carry many crossings.
+static FBBezierPath FBBenchHatchLines(size_t grid, FBFloat offset) {
+  FBBezierPath path;
+  for (size_t row = 0; row < grid; row++) {
+    FBPoint origin = {offset - FBBenchCellSize / 2.0, row * FBBenchCellSize + offset + FBBenchShapeSize / 4.0};
+    addRectangle(path, {origin, {grid * FBBenchCellSize, FBBenchShapeSize / 2.0}});
+  }
+  return path;
+}
+
+static FBBenchWorkload FBBenchMakeWorkload(std::string name, size_t grid, FBBezierPath path1, FBBezierPath path2) {
+  auto graph1 = std::make_shared<FBBezierGraph>(path1);
+  auto graph2 = std::make_shared<FBBezierGraph>(path2);
+  return {std::move(name), grid, std::move(path1), std::move(path2), std::move(graph1), std::move(graph2)};
+}
+
+static std::vector<FBBenchWorkload> FBBenchMakeWorkloads(size_t maxGrid) {
+  std::vector<FBBenchWorkload> workloads;
+  const FBFloat offset = FBBenchShapeSize / 2.0;
+  for (size_t grid = 1; grid <= maxGrid; grid *= 2) {
+    workloads.push_back(
+        FBBenchMakeWorkload("rectangles", grid, FBBenchRectangles(grid, 0.0), FBBenchRectangles(grid, offset)));
+    workloads.push_back(FBBenchMakeWorkload("circles", grid, FBBenchCircles(grid, 0.0), FBBenchCircles(grid, offset)));
+    workloads.push_back(
+        FBBenchMakeWorkload("arcs", grid, FBBenchArcShapes(grid, 0.0), FBBenchArcShapes(grid, offset)));
+    workloads.push_back(FBBenchMakeWorkload("mixed", grid, FBBenchMixed(grid, 0.0), FBBenchArcShapes(grid, offset)));
+    workloads.push_back(
+        FBBenchMakeWorkload("hatch", grid, FBBenchHatchLines(grid, 0.0), FBBenchCircles(grid, offset)));
+  }
+  return workloads;
+}
+
+// Number of contours and edges the boolean engine sees for the given path.
+static std::pair<size_t, size_t> FBBenchGraphSize(FBBezierGraph &graph) {
+  size_t edges = 0;
+  for (const auto &contour : graph.contours()) {
+    edges += contour->edges().size();
+  }
+  return {graph.contours().size(), edges};
+}
+
+// MARK: ********** Operations **********
+
+template <FBBezierPath (FBBezierPath::*Method)(const FBBezierPath &, FBBooleanStats *) const>
+static size_t FBBenchBooleanOperation(const FBBenchWorkload &workload) {
+  return (workload.path1.*Method)(workload.path2, nullptr).size();
+}
+
+static size_t FBBenchAllBooleanResults(const FBBenchWorkload &workload) {
+  auto results = workload.path1.allBooleanResults(workload.path2);
+  return results.unionPath.size() + results.intersectPath.size() + results.differencePath.size()
+         + results.xorPath.size();
+}
+
+static size_t FBBenchCurveIntersections(const FBBenchWorkload &workload) {
+  size_t count = 0;
+  for (const auto &contour1 : workload.graph1->contours()) {
+    for (const auto &edge1 : contour1->edges()) {
+      for (const auto &contour2 : workload.graph2->contours()) {
+        for (const auto &edge2 : contour2->edges()) {
+          edge1->intersectionsWithBezierCurve(
+              edge2, nullptr,
+              [&](const std::shared_ptr<FBBezierIntersection> &intersection, bool *stop) { ++count; });
+        }
+      }
+    }
+  }
+  return count;
+}
+
+static size_t FBBenchRayIntersections(const FBBenchWorkload &workload) {
+  size_t count = 0;
+  for (const auto &contour2 : workload.graph2->contours()) {
+    for (const auto &edge2 : contour2->edges()) {
+      for (const auto &contour1 : workload.graph1->contours()) {
+        if (contour1->containsPoint(std::get<0>(edge2->pointAtParameter(0.5)))) {
+          ++count;
+        }
+      }
+    }
+  }
+  return count;
+}
+
+// MARK: ********** Measurement **********
+
+struct FBBenchResult {
+  double opsPerSecond;
+  double p50Microseconds;
+  double p99Microseconds;
+  size_t peakHeapBytes;
+  size_t resultElements;
+};
+
+static double FBBenchPercentile(const std::vector<double> &sortedSamples, double percentile) {
+  if (sortedSamples.empty()) {
+    return 0.0;
+  }
+  size_t rank = static_cast<size_t>(percentile * (sortedSamples.size() - 1) + 0.5);
+  return sortedSamples[std::min(rank, sortedSamples.size() - 1)];
+}
+
+static FBBenchResult FBBenchRun(const FBBenchWorkload &workload, const FBBenchOperation &operation,
+                                size_t iterations) {
+  using clock = std::chrono::steady_clock;
+
+  FBBenchResult result{};
+  // Warm up once; this also provides the size of the result.
+  result.resultElements = operation.run(workload);
+
+  FBBenchResetPeak();
+  size_t baseline = FBBenchLiveBytes.load();
+  std::vector<double> samples;
+  samples.reserve(iterations);
+  auto totalStart = clock::now();
+  for (size_t i = 0; i < iterations; i++) {
+    auto start = clock::now();
+    operation.run(workload);
+    auto stop = clock::now();
+    samples.push_back(std::chrono::duration<double, std::micro>(stop - start).count());
+  }
+  double totalSeconds = std::chrono::duration<double>(clock::now() - totalStart).count();
+  result.peakHeapBytes = FBBenchPeakBytes.load() - baseline;
+
+  std::sort(samples.begin(), samples.end());
+  result.opsPerSecond = totalSeconds > 0.0 ? iterations / totalSeconds : 0.0;
+  result.p50Microseconds = FBBenchPercentile(samples, 0.50);
+  result.p99Microseconds = FBBenchPercentile(samples, 0.99);
+  return result;
+}
+
+// MARK: ********** Main **********
+
+static void FBBenchUsage(const char *program) {
+  std::fprintf(stderr, "usage: %s [--iterations N] [--max-grid N] [--workload NAME] [--threads N]\n", program);
+}
+
+int main(int argc, char *argv[]) {
+  size_t iterations = 20;
+  size_t maxGrid = 8;
+  std::string workloadFilter;
+  for (int i = 1; i < argc; i++) {
+    bool hasValue = i + 1 < argc;
+    if (std::strcmp(argv[i], "--iterations") == 0 && hasValue) {
+      iterations = std::max<size_t>(1, std::strtoul(argv[++i], nullptr, 10));
+    } else if (std::strcmp(argv[i], "--max-grid") == 0 && hasValue) {
+      maxGrid = std::max<size_t>(1, std::strtoul(argv[++i], nullptr, 10));
+    } else if (std::strcmp(argv[i], "--workload") == 0 && hasValue) {
+      workloadFilter = argv[++i];
+    } else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+      FBSetThreadCount(std::strtoul(argv[++i], nullptr, 10));
+    } else {
+      FBBenchUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  static const FBBenchOperation operations[] = {
+      {"union", &FBBenchBooleanOperation<&FBBezierPath::unionWithPath>},
+      {"intersect", &FBBenchBooleanOperation<&FBBezierPath::intersectWithPath>},
+      {"difference", &FBBenchBooleanOperation<&FBBezierPath::differenceWithPath>},
+      {"xor", &FBBenchBooleanOperation<&FBBezierPath::xorWithPath>},
+      {"all", &FBBenchAllBooleanResults},
+      {"curve_intersections", &FBBenchCurveIntersections},
+      {"ray_intersections", &FBBenchRayIntersections},
+  };
+
+  std::string json = std::format(
+      "{{\n  \"benchmark\": \"vectorboolean\",\n  \"iterations\": {},\n  \"threads\": {},\n  \"results\": [",
+      iterations, FBThreadCount());
+  bool first = true;
+  for (const auto &workload : FBBenchMakeWorkloads(maxGrid)) {
+    if (!workloadFilter.empty() && workload.name != workloadFilter) {
+      continue;
+    }
+    for (const auto &operation : operations) {
+      FBBenchResult result = FBBenchRun(workload, operation, iterations);
+      auto [contours1, edges1] = FBBenchGraphSize(*workload.graph1);
+      auto [contours2, edges2] = FBBenchGraphSize(*workload.graph2);
+      json += first ? "\n" : ",\n";
+      first = false;
+      json += std::format("    {{\"workload\": \"{}\", \"grid\": {}, \"contours\": {}, \"edges\": {}, "
+                          "\"operation\": \"{}\", \"ops_per_sec\": {}, \"p50_us\": {}, \"p99_us\": {}, "
+                          "\"peak_heap_bytes\": {}, \"result_elements\": {}}}",
+                          workload.name, workload.grid,
+                          contours1 + contours2, edges1 + edges2, operation.name,
+                          result.opsPerSecond, result.p50Microseconds, result.p99Microseconds, result.peakHeapBytes,
+                          result.resultElements);
+    }
+  }
+  json += std::format("\n  ],\n  \"max_rss_kb\": {}\n}}\n", FBBenchMaxResidentKilobytes());
+  std::fputs(json.c_str(), stdout);
+  return 0;
+}
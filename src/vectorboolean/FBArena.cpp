@@ -0,0 +1,48 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FBArena.hpp"
+
+namespace fb {
+
+// Size of the first block the arena asks the heap for; later blocks grow geometrically
+static const std::size_t FBOperationArenaInitialSize = 64 * 1024;
+
+static thread_local FBOperationArena *FBCurrentOperationArena = nullptr;
+
+FBOperationArena::FBOperationArena()
+    : _resource(FBOperationArenaInitialSize)
+    , _previous(FBCurrentOperationArena) {
+  FBCurrentOperationArena = this;
+}
+
+FBOperationArena::~FBOperationArena() { FBCurrentOperationArena = _previous; }
+
+std::pmr::memory_resource *FBOperationArena::currentResource() {
+  return FBCurrentOperationArena != nullptr ? &FBCurrentOperationArena->_resource : nullptr;
+}
+
+} // namespace fb
@@ -0,0 +1,66 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "FBCommon.hpp"
+
+#include <memory_resource>
+
+namespace fb {
+
+// FBOperationArena is a monotonic arena that the nodes of the graphs (curves, contours, crossings,
+//  intersections, overlaps) are allocated from while a boolean operation runs. Creating one makes
+//  it the current arena for the calling thread until it's destroyed; the arena that was current
+//  before is restored then. Nodes are never freed one by one, the whole arena is released at once
+//  when it's destroyed, so every node allocated from it must be gone by then. FBBezierPath's
+//  boolean operations create one around building the graphs and converting the result back into
+//  a path, which is the whole lifetime of the nodes.
+class FBOperationArena {
+  std::pmr::monotonic_buffer_resource _resource;
+  FBOperationArena *_previous;
+
+public:
+  FBOperationArena();
+  ~FBOperationArena();
+  FBOperationArena(const FBOperationArena &) = delete;
+  FBOperationArena &operator=(const FBOperationArena &) = delete;
+
+  // The memory resource of the calling thread's current arena, or nullptr if there isn't one
+  static std::pmr::memory_resource *currentResource();
+};
+
+// Drop-in replacement for std::make_shared for graph nodes. Allocates the object (and its control
+//  block) from the calling thread's current FBOperationArena if there is one, and from the heap
+//  otherwise.
+template <typename T, typename... Args> std::shared_ptr<T> FBMakeShared(Args &&...args) {
+  if (auto resource = FBOperationArena::currentResource()) {
+    return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(resource), std::forward<Args>(args)...);
+  }
+  return std::make_shared<T>(std::forward<Args>(args)...);
+}
+
+} // namespace fb
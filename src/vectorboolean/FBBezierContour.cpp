@@ -26,9 +26,11 @@ OTHER DEALINGS IN THE SOFTWARE.
 
 #include "FBBezierContour.hpp"
 
+#include "FBArena.hpp"
 #include "FBBezierCurve.hpp"
 #include "FBBezierIntersectRange.hpp"
 #include "FBBezierIntersection.hpp"
+#include "FBContourAdjacency.hpp"
 #include "FBContourOverlap.hpp"
 #include "FBCurveLocation.hpp"
 #include "FBEdgeCrossing.hpp"
@@ -174,7 +176,7 @@ bool FBBezierContour::containsPoint(FBPoint testPoint) const {
   //  odd number, we're inside the graph, if even, outside.
   FBPoint lineEndPoint = FBMakePoint(testPoint.x > FBMinX(bounds()) ? FBMinX(bounds()) - 10 : FBMaxX(bounds()) + 10,
                                      testPoint.y); /* just move us outside the bounds of the graph */
-  auto testCurve = std::make_shared<FBBezierCurve>(testPoint, lineEndPoint);
+  auto testCurve = FBMakeShared<FBBezierCurve>(testPoint, lineEndPoint);
 
   size_t intersectCount = numberOfIntersectionsWithRay(testCurve);
   return (intersectCount & 1) == 1;
@@ -182,13 +184,13 @@ bool FBBezierContour::containsPoint(FBPoint testPoint) const {
 
 size_t FBBezierContour::numberOfIntersectionsWithRay(std::shared_ptr<FBBezierCurve> testEdge) const {
   std::size_t count = 0;
-  intersectionsWithRay(testEdge, [&](std::shared_ptr<FBBezierIntersection> inersection) { ++count; });
+  intersectionsWithRay(testEdge, [&](const std::shared_ptr<FBBezierIntersection> &inersection) { ++count; });
   return count;
 }
 
 void FBBezierContour::intersectionsWithRay(
     std::shared_ptr<FBBezierCurve> testEdge,
-    std::function<void(std::shared_ptr<FBBezierIntersection> intersection)> block) const {
+    FBFunctionRef<void(const std::shared_ptr<FBBezierIntersection> &intersection)> block) const {
   std::shared_ptr<FBBezierIntersection> firstIntersection = nullptr;
   std::shared_ptr<FBBezierIntersection> previousIntersection = nullptr;
 
@@ -197,8 +199,8 @@ void FBBezierContour::intersectionsWithRay(
     // Check for intersections between our test ray and the rest of the bezier
     // graph
     std::shared_ptr<FBBezierIntersectRange> intersectRange = nullptr;
-    testEdge->intersectionsWithBezierCurve(
-        edge, &intersectRange, [&](std::shared_ptr<FBBezierIntersection> intersection, bool *stop) {
+    testEdge->rayIntersectionsWithBezierCurve(
+        edge, &intersectRange, [&](const std::shared_ptr<FBBezierIntersection> &intersection, bool *stop) {
           // Make sure this is a proper crossing
           if (!testEdge->crossesEdge(edge, intersection) || edge->isPoint()) { // don't count tangents
             return;
@@ -294,7 +296,7 @@ std::tuple<std::shared_ptr<FBBezierCurve>, FBPoint, FBFloat> FBBezierContour::st
 }
 
 void FBBezierContour::markCrossingsAsEntryOrExitWithContour(std::shared_ptr<FBBezierContour> otherContour,
-                                                            bool markInside) {
+                                                            bool markInside, const FBContourAdjacency &adjacency) {
   // Go through and mark all the crossings with the given contour as "entry" or "exit". This
   //  determines what part of ths contour is outputted.
 
@@ -305,34 +307,35 @@ void FBBezierContour::markCrossingsAsEntryOrExitWithContour(std::shared_ptr<FBBe
 
   // Calculate the first entry value. We need to determine if the edge we're starting
   //  on is inside or outside the otherContour.
-  bool contains = otherContour->contourAndSelfIntersectingContoursContainPoint(startPoint);
+  bool contains = otherContour->contourAndSelfIntersectingContoursContainPoint(startPoint, adjacency);
   bool isEntry = markInside ? !contains : contains;
-  auto otherContours = otherContour->selfIntersectingContours();
-  otherContours.push_back(otherContour);
+  // Crossings with the other contour, or any contour it self intersects with, get marked
+  auto otherComponent = adjacency.component(otherContour->adjacencyIndex());
 
   static const FBFloat FBStopParameterNoLimit = 2.0; // needs to be > 1.0
   static const FBFloat FBStartParameterNoLimit = 0.0;
 
   // Walk all the edges in this contour and mark the crossings
-  isEntry = markCrossingsOnEdge(startEdge, startParameter, FBStopParameterNoLimit, otherContours, isEntry);
+  isEntry = markCrossingsOnEdge(startEdge, startParameter, FBStopParameterNoLimit, adjacency, otherComponent,
+                                isEntry);
   auto edge = startEdge->next();
   while (edge != startEdge) {
-    isEntry = markCrossingsOnEdge(edge, FBStartParameterNoLimit, FBStopParameterNoLimit, otherContours, isEntry);
+    isEntry = markCrossingsOnEdge(edge, FBStartParameterNoLimit, FBStopParameterNoLimit, adjacency, otherComponent,
+                                  isEntry);
     edge = edge->next();
   }
-  markCrossingsOnEdge(startEdge, FBStartParameterNoLimit, startParameter, otherContours, isEntry);
+  markCrossingsOnEdge(startEdge, FBStartParameterNoLimit, startParameter, adjacency, otherComponent, isEntry);
 }
 
 bool FBBezierContour::markCrossingsOnEdge(std::shared_ptr<FBBezierCurve> edge, FBFloat startParameter,
-                                          FBFloat stopParameter,
-                                          const std::vector<std::shared_ptr<FBBezierContour>> &otherContours,
-                                          bool startIsEntry) {
+                                          FBFloat stopParameter, const FBContourAdjacency &adjacency,
+                                          size_t otherComponent, bool startIsEntry) {
   bool isEntry = startIsEntry;
   // Mark all the crossings on this edge
-  edge->crossingsWithBlock([&](std::shared_ptr<FBEdgeCrossing> crossing, bool *stop) {
+  edge->crossingsWithBlock([&](const std::shared_ptr<FBEdgeCrossing> &crossing, bool *stop) {
     // skip over other contours
     if (crossing->isSelfCrossing()
-        || !std::ranges::contains(otherContours, crossing->counterpart()->edge()->contour())) {
+        || adjacency.component(crossing->counterpart()->edge()->contour()->adjacencyIndex()) != otherComponent) {
       return;
     }
     if (crossing->parameter() < startParameter || crossing->parameter() >= stopParameter) {
@@ -344,14 +347,12 @@ bool FBBezierContour::markCrossingsOnEdge(std::shared_ptr<FBBezierCurve> edge, F
   return isEntry;
 }
 
-bool FBBezierContour::contourAndSelfIntersectingContoursContainPoint(FBPoint point) {
+bool FBBezierContour::contourAndSelfIntersectingContoursContainPoint(FBPoint point,
+                                                                     const FBContourAdjacency &adjacency) const {
+  // The component holds this contour as well as the ones it self intersects with
   std::size_t containerCount = 0;
-  if (containsPoint(point)) {
-    ++containerCount;
-  }
-  auto intersectingContours = selfIntersectingContours();
-  for (const auto &contour : intersectingContours) {
-    if (contour->containsPoint(point)) {
+  for (auto contour : adjacency.componentContours(adjacency.component(_adjacencyIndex))) {
+    if (adjacency.contour(contour)->containsPoint(point)) {
       ++containerCount;
     }
   }
@@ -368,12 +369,12 @@ void FBBezierContour::close() {
   auto last = _edges[_edges.size() - 1];
 
   if (!FBArePointsClose(first->endPoint1(), last->endPoint2())) {
-    addCurve(std::make_shared<FBBezierCurve>(last->endPoint2(), first->endPoint1()));
+    addCurve(FBMakeShared<FBBezierCurve>(last->endPoint2(), first->endPoint1()));
   }
 }
 
 std::shared_ptr<FBBezierContour> FBBezierContour::reversedContour() const {
-  auto revContour = std::make_shared<FBBezierContour>();
+  auto revContour = FBMakeShared<FBBezierContour>();
 
   for (const auto &edge : _edges) {
     revContour->addReverseCurve(edge);
@@ -414,7 +415,7 @@ std::shared_ptr<FBBezierContour> FBBezierContour::contourMadeClockwiseIfNecessar
 bool FBBezierContour::crossesOwnContour(std::shared_ptr<FBBezierContour> contour) {
   for (const auto &edge : _edges) {
     bool intersects = false;
-    edge->crossingsWithBlock([&](std::shared_ptr<FBEdgeCrossing> crossing, bool *stop) {
+    edge->crossingsWithBlock([&](const std::shared_ptr<FBEdgeCrossing> &crossing, bool *stop) {
       if (!crossing->isSelfCrossing()) {
         return; // Only want the self intersecting crossings
       }
@@ -435,7 +436,7 @@ std::vector<std::shared_ptr<FBBezierContour>> FBBezierContour::intersectingConto
   // Go and find all the unique contours that intersect this specific contour
   std::vector<std::shared_ptr<FBBezierContour>> contours;
   for (const auto &edge : _edges) {
-    edge->intersectingEdgesWithBlock([&](std::shared_ptr<FBBezierCurve> intersectingEdge) {
+    edge->intersectingEdgesWithBlock([&](const std::shared_ptr<FBBezierCurve> &intersectingEdge) {
       if (!std::ranges::contains(contours, intersectingEdge->contour())) {
         contours.push_back(intersectingEdge->contour());
       }
@@ -444,26 +445,6 @@ std::vector<std::shared_ptr<FBBezierContour>> FBBezierContour::intersectingConto
   return contours;
 }
 
-std::vector<std::shared_ptr<FBBezierContour>> FBBezierContour::selfIntersectingContours() {
-  // Go and find all the unique contours that intersect this specific contour from our own graph
-  std::vector<std::shared_ptr<FBBezierContour>> contours;
-  addSelfIntersectingContoursToArray(contours, shared_from_this());
-  return contours;
-}
-
-void FBBezierContour::addSelfIntersectingContoursToArray(std::vector<std::shared_ptr<FBBezierContour>> &contours,
-                                                         std::shared_ptr<FBBezierContour> originalContour) const {
-  for (const auto &edge : _edges) {
-    edge->selfIntersectingEdgesWithBlock([&](std::shared_ptr<FBBezierCurve> intersectingEdge) {
-      if (intersectingEdge->contour() != originalContour
-          && !std::ranges::contains(contours, intersectingEdge->contour())) {
-        contours.push_back(intersectingEdge->contour());
-        intersectingEdge->contour()->addSelfIntersectingContoursToArray(contours, originalContour);
-      }
-    });
-  }
-}
-
 void FBBezierContour::addOverlap(std::shared_ptr<FBContourOverlap> overlap) {
   if (overlap->isEmpty()) {
     return;
@@ -483,9 +464,113 @@ bool FBBezierContour::isEquivalent(std::shared_ptr<FBBezierContour> other) const
   return false;
 }
 
-void FBBezierContour::forEachEdgeOverlapDo(std::function<void(std::shared_ptr<FBEdgeOverlap> overlap)> block) {
+void FBBezierContour::equivalentContoursWithBlock(
+    FBFunctionRef<void(const std::shared_ptr<FBBezierContour> &contour)> block) const {
   for (const auto &overlap : _overlaps) {
-    overlap->runsWithBlock([&](std::shared_ptr<FBEdgeOverlapRun> run, bool *stop) {
+    if (!overlap->isComplete()) {
+      continue;
+    }
+    auto contour1 = overlap->contour1();
+    auto contour2 = overlap->contour2();
+    if (contour1.get() == this) {
+      block(contour2);
+    } else if (contour2.get() == this) {
+      block(contour1);
+    }
+  }
+}
+
+// splitmix64's finalizer
+static uint64_t FBMixHash(uint64_t hash) {
+  hash ^= hash >> 30;
+  hash *= 0xbf58476d1ce4e5b9ULL;
+  hash ^= hash >> 27;
+  hash *= 0x94d049bb133111ebULL;
+  hash ^= hash >> 31;
+  return hash;
+}
+
+// Hashes the points of a curve in the given order, so a curve and its reverse hash differently
+static uint64_t FBHashCurvePoints(std::initializer_list<FBPoint> points) {
+  uint64_t hash = 0;
+  for (auto point : points) {
+    hash = FBMixHash(hash ^ std::hash<FBFloat>{}(point.x));
+    hash = FBMixHash(hash ^ std::hash<FBFloat>{}(point.y));
+  }
+  return hash;
+}
+
+uint64_t FBBezierContour::fingerprint() const {
+  // Each edge hashes the same read either way, and the edges are summed, so the fingerprint
+  //  doesn't depend on where the contour starts or which way it goes. A straight line's control
+  //  points follow from its end points, and may round differently when it's drawn the other way,
+  //  so only its end points count.
+  uint64_t fingerprint = FBMixHash(_edges.size());
+  for (const auto &edge : _edges) {
+    const auto &data = edge->data();
+    uint64_t forward = 0;
+    uint64_t backward = 0;
+    if (data.isStraightLine) {
+      forward = FBHashCurvePoints({data.endPoint1, data.endPoint2});
+      backward = FBHashCurvePoints({data.endPoint2, data.endPoint1});
+    } else {
+      forward = FBHashCurvePoints({data.endPoint1, data.controlPoint1, data.controlPoint2, data.endPoint2});
+      backward = FBHashCurvePoints({data.endPoint2, data.controlPoint2, data.controlPoint1, data.endPoint1});
+    }
+    fingerprint += FBMixHash(std::min(forward, backward) + data.isStraightLine);
+  }
+  return fingerprint;
+}
+
+// Whether the curves are the same, reversed or not. Straight lines are compared by their end points.
+static bool FBAreCurvesIdentical(const FBBezierCurveData &curve1, const FBBezierCurveData &curve2, bool reversed) {
+  if (curve1.isStraightLine != curve2.isStraightLine) {
+    return false;
+  }
+  if (curve1.isStraightLine) {
+    if (reversed) {
+      return FBEqualPoints(curve1.endPoint1, curve2.endPoint2) && FBEqualPoints(curve1.endPoint2, curve2.endPoint1);
+    }
+    return FBEqualPoints(curve1.endPoint1, curve2.endPoint1) && FBEqualPoints(curve1.endPoint2, curve2.endPoint2);
+  }
+  if (reversed) {
+    return FBEqualPoints(curve1.endPoint1, curve2.endPoint2)
+           && FBEqualPoints(curve1.controlPoint1, curve2.controlPoint2)
+           && FBEqualPoints(curve1.controlPoint2, curve2.controlPoint1)
+           && FBEqualPoints(curve1.endPoint2, curve2.endPoint1);
+  }
+  return FBEqualPoints(curve1.endPoint1, curve2.endPoint1) && FBEqualPoints(curve1.controlPoint1, curve2.controlPoint1)
+         && FBEqualPoints(curve1.controlPoint2, curve2.controlPoint2)
+         && FBEqualPoints(curve1.endPoint2, curve2.endPoint2);
+}
+
+bool FBBezierContour::isIdentical(const FBBezierContour &other, size_t *offset, bool *reversed) const {
+  size_t count = _edges.size();
+  if (count == 0 || count != other._edges.size()) {
+    return false;
+  }
+  // Try every edge of other that matches our first edge as the place to line the contours up
+  for (size_t candidate = 0; candidate < count; candidate++) {
+    for (bool backwards : {false, true}) {
+      bool identical = true;
+      for (size_t index = 0; index < count && identical; index++) {
+        size_t otherIndex = backwards ? (candidate + count - index) % count : (candidate + index) % count;
+        identical = FBAreCurvesIdentical(_edges[index]->data(), other._edges[otherIndex]->data(), backwards);
+      }
+      if (identical) {
+        *offset = candidate;
+        *reversed = backwards;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void FBBezierContour::forEachEdgeOverlapDo(
+    FBFunctionRef<void(const std::shared_ptr<FBEdgeOverlap> &overlap)> block) {
+  for (const auto &overlap : _overlaps) {
+    overlap->runsWithBlock([&](const std::shared_ptr<FBEdgeOverlapRun> &run, bool *stop) {
       for (const auto &edgeOverlap : run->overlaps()) {
         block(edgeOverlap);
       }
@@ -512,13 +597,25 @@ bool FBBezierContour::doesOverlapContainParameter(FBFloat parameter, std::shared
 }
 
 std::shared_ptr<FBBezierContour> FBBezierContour::copy() const {
-  auto copy = std::make_shared<FBBezierContour>();
+  auto copy = FBMakeShared<FBBezierContour>();
   for (const auto &edge : _edges) {
     copy->addCurve(edge);
   }
   return copy;
 }
 
+std::shared_ptr<FBBezierContour> FBBezierContour::clone() const {
+  auto clone = FBMakeShared<FBBezierContour>();
+  clone->_edges.reserve(_edges.size());
+  for (const auto &edge : _edges) {
+    clone->addCurve(edge->clone());
+  }
+  clone->_bounds = _bounds;
+  clone->_boundingRect = _boundingRect;
+  clone->_inside = _inside;
+  return clone;
+}
+
 std::shared_ptr<FBCurveLocation> FBBezierContour::closestLocationToPoint(FBPoint point) {
   std::shared_ptr<FBBezierCurve> closestEdge = nullptr;
   FBBezierCurveLocation location = {};
@@ -535,7 +632,7 @@ std::shared_ptr<FBCurveLocation> FBBezierContour::closestLocationToPoint(FBPoint
     return nullptr;
   }
 
-  auto curveLocation = std::make_shared<FBCurveLocation>(closestEdge, location.parameter, location.distance);
+  auto curveLocation = FBMakeShared<FBCurveLocation>(closestEdge, location.parameter, location.distance);
   curveLocation->setContour(shared_from_this());
   return curveLocation;
 }
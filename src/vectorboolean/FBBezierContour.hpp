@@ -27,10 +27,15 @@ OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 #include "FBCommon.hpp"
+#include "FBFunctionRef.hpp"
+
+#include <cstdint>
+#include <span>
 
 namespace fb {
 
 class FBBezierCurve;
+class FBContourAdjacency;
 class FBContourOverlap;
 class FBEdgeCrossing;
 class FBBezierIntersection;
@@ -46,17 +51,15 @@ private:
   std::vector<std::shared_ptr<FBBezierCurve>> _edges;
   mutable FBRect _bounds;       // cache
   mutable FBRect _boundingRect; // cache
-  FBContourInside _inside;
+  FBContourInside _inside = FBContourInsideFilled;
   std::vector<std::shared_ptr<FBContourOverlap>> _overlaps;
+  size_t _adjacencyIndex = 0;
 
 protected:
-  bool contourAndSelfIntersectingContoursContainPoint(FBPoint point);
-  void addSelfIntersectingContoursToArray(std::vector<std::shared_ptr<FBBezierContour>> &contours,
-                                          std::shared_ptr<FBBezierContour> originalContour) const;
+  bool contourAndSelfIntersectingContoursContainPoint(FBPoint point, const FBContourAdjacency &adjacency) const;
   std::tuple<std::shared_ptr<FBBezierCurve>, FBPoint, FBFloat> startingEdge() const;
   bool markCrossingsOnEdge(std::shared_ptr<FBBezierCurve> edge, FBFloat startParameter, FBFloat stopParameter,
-                           const std::vector<std::shared_ptr<FBBezierContour>> &otherContours, bool isEntry);
-  std::vector<std::shared_ptr<FBBezierContour>> selfIntersectingContours();
+                           const FBContourAdjacency &adjacency, size_t otherComponent, bool isEntry);
 
 public:
   // Methods for building up the contour. The reverse forms flip points in the bezier curve before
@@ -70,10 +73,11 @@ public:
   void addReverseCurve(std::shared_ptr<FBEdgeCrossing> startCrossing, std::shared_ptr<FBEdgeCrossing> endCrossing);
 
   void intersectionsWithRay(std::shared_ptr<FBBezierCurve> testEdge,
-                            std::function<void(std::shared_ptr<FBBezierIntersection> intersection)> block) const;
+                            FBFunctionRef<void(const std::shared_ptr<FBBezierIntersection> &intersection)> block) const;
   size_t numberOfIntersectionsWithRay(std::shared_ptr<FBBezierCurve> testEdge) const;
   bool containsPoint(FBPoint testPoint) const;
-  void markCrossingsAsEntryOrExitWithContour(std::shared_ptr<FBBezierContour> otherContour, bool markInside);
+  void markCrossingsAsEntryOrExitWithContour(std::shared_ptr<FBBezierContour> otherContour, bool markInside,
+                                             const FBContourAdjacency &adjacency);
 
   void close();
 
@@ -84,27 +88,43 @@ public:
   void addOverlap(std::shared_ptr<FBContourOverlap> overlap);
   void removeAllOverlaps();
   bool isEquivalent(std::shared_ptr<FBBezierContour> other) const;
+  // Calls block with each contour isEquivalent() is true for
+  void equivalentContoursWithBlock(FBFunctionRef<void(const std::shared_ptr<FBBezierContour> &contour)> block) const;
+
+  // A hash of the edges that doesn't depend on which edge the contour starts at or which way it
+  //  goes around. Contours with the same fingerprint may still differ; isIdentical() tells.
+  uint64_t fingerprint() const;
+  // Whether other is made of exactly the same edges, possibly starting at a different one or going
+  //  the other way around. If so, edge i of this contour is edge (offset + i) % n of other, or the
+  //  reverse of edge (offset + n - i) % n when reversed is set.
+  bool isIdentical(const FBBezierContour &other, size_t *offset, bool *reversed) const;
 
   std::shared_ptr<FBBezierCurve> startEdge() const;
   FBPoint testPointForContainment() const;
 
   std::shared_ptr<FBCurveLocation> closestLocationToPoint(FBPoint point);
 
-  const std::vector<std::shared_ptr<FBBezierCurve>> edges() const { return _edges; }
+  // A view of the edges, valid until the contour is edited. Doesn't copy the vector.
+  std::span<const std::shared_ptr<FBBezierCurve>> edges() const { return _edges; }
   FBRect bounds() const;
   FBRect boundingRect() const;
   FBPoint firstPoint() const;
   FBContourInside inside() const { return _inside; }
   void setInside(FBContourInside inside) { _inside = inside; }
   std::vector<std::shared_ptr<FBBezierContour>> intersectingContours() const;
+  // The contour's number in the FBContourAdjacency of the boolean operation it's part of
+  size_t adjacencyIndex() const { return _adjacencyIndex; }
+  void setAdjacencyIndex(size_t adjacencyIndex) { _adjacencyIndex = adjacencyIndex; }
 
   bool crossesOwnContour(std::shared_ptr<FBBezierContour> contour);
 
-  void forEachEdgeOverlapDo(std::function<void(std::shared_ptr<FBEdgeOverlap> overlap)> block);
+  void forEachEdgeOverlapDo(FBFunctionRef<void(const std::shared_ptr<FBEdgeOverlap> &overlap)> block);
   bool doesOverlapContainCrossing(std::shared_ptr<FBEdgeCrossing> crossing) const;
   bool doesOverlapContainParameter(FBFloat parameter, std::shared_ptr<FBBezierCurve> edge) const;
 
   std::shared_ptr<FBBezierContour> copy() const;
+  // Copies the edges too, with their cached values, but not their crossings or overlaps
+  std::shared_ptr<FBBezierContour> clone() const;
 
   std::string str(int indent = -1) const;
 };
@@ -25,15 +25,20 @@ OTHER DEALINGS IN THE SOFTWARE.
 */
 
 #include "FBBezierCurve.hpp"
+#include "FBArena.hpp"
 #include "FBBezierContour.hpp"
 #include "FBBezierIntersectRange.hpp"
 #include "FBBezierIntersection.hpp"
 #include "FBEdgeCrossing.hpp"
 #include "FBGeometry.hpp"
+#include "FBIntersectionCounters.hpp"
+#include "FBTrace.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <format>
 #include <iostream>
+#include <limits>
 
 namespace fb {
 
@@ -113,18 +118,6 @@ static FBFloat FBParameterOfPointOnLine(FBPoint lineStart, FBPoint lineEnd, FBPo
   return parameter;
 }
 
-static bool FBLinesIntersect(FBPoint line1Start, FBPoint line1End, FBPoint line2Start, FBPoint line2End,
-                             FBPoint *outIntersect) {
-  FBNormalizedLine line1 = FBNormalizedLineMake(line1Start, line1End);
-  FBNormalizedLine line2 = FBNormalizedLineMake(line2Start, line2End);
-  *outIntersect = FBNormalizedLineIntersection(line1, line2);
-  if (std::isnan(outIntersect->x) || std::isnan(outIntersect->y)) {
-    return false;
-  }
-  outIntersect->y = -outIntersect->y;
-  return true;
-}
-
 // The three points are a counter-clockwise turn if the return value is greater than 0,
 //  clockwise if less than 0, or colinear if 0.
 static FBFloat CounterClockwiseTurn(FBPoint point1, FBPoint point2, FBPoint point3) {
@@ -621,8 +614,8 @@ static bool FBIsControlPolygonFlatEnough(FBPoint *bezierPoints, size_t degree, F
   return false;
 }
 
-static void FBFindBezierRootsWithDepth(FBPoint *bezierPoints, size_t degree, size_t depth,
-                                       std::function<void(FBFloat root)> block) {
+template <typename RootBlock>
+static void FBFindBezierRootsWithDepth(FBPoint *bezierPoints, size_t degree, size_t depth, RootBlock &block) {
   size_t crossingCount = FBCountBezierCrossings(bezierPoints, degree);
   if (crossingCount == 0) {
     return;
@@ -647,7 +640,9 @@ static void FBFindBezierRootsWithDepth(FBPoint *bezierPoints, size_t degree, siz
   FBFindBezierRootsWithDepth(rightCurve, degree, depth + 1, block);
 }
 
-static void FBFindBezierRoots(FBPoint *bezierPoints, size_t degree, std::function<void(FBFloat root)> block) {
+// The block is called with each root; it is a template parameter so the call inlines
+template <typename RootBlock>
+static void FBFindBezierRoots(FBPoint *bezierPoints, size_t degree, RootBlock block) {
   FBFindBezierRootsWithDepth(bezierPoints, degree, 0, block);
 }
 
@@ -1300,13 +1295,15 @@ static bool FBBezierCurveDataCheckForOverlapRange(FBBezierCurveData me,
                                                   std::shared_ptr<const FBBezierCurve> originalThem,
                                                   FBBezierCurveData us, FBBezierCurveData them) {
   if (FBBezierCurveDataAreCurvesEqual(us, them)) {
+    FBCountIntersectionWork(&FBIntersectionCounters::overlapRanges);
     if (intersectRange != nullptr) {
-      *intersectRange = std::make_shared<FBBezierIntersectRange>(originalUs, *usRange, originalThem, *themRange, false);
+      *intersectRange = FBMakeShared<FBBezierIntersectRange>(originalUs, *usRange, originalThem, *themRange, false);
     }
     return true;
   } else if (FBBezierCurveDataAreCurvesEqual(us, FBBezierCurveDataReversed(them))) {
+    FBCountIntersectionWork(&FBIntersectionCounters::overlapRanges);
     if (intersectRange != nullptr) {
-      *intersectRange = std::make_shared<FBBezierIntersectRange>(originalUs, *usRange, originalThem, *themRange, true);
+      *intersectRange = FBMakeShared<FBBezierIntersectRange>(originalUs, *usRange, originalThem, *themRange, true);
     }
     return true;
   }
@@ -1399,6 +1396,7 @@ static FBFloat FBBezierCurveDataRefineParameter(FBBezierCurveData me, FBFloat pa
   //
   //  f'(parameter) = (Q(parameter) - point) * Q''(parameter) + Q'(parameter) * Q'(parameter)
   //
+  FBCountIntersectionWork(&FBIntersectionCounters::newtonRefinements);
 
   FBPoint bezierPoints[4] = {me.endPoint1, me.controlPoint1, me.controlPoint2, me.endPoint2};
 
@@ -1431,6 +1429,137 @@ static FBFloat FBBezierCurveDataRefineParameter(FBBezierCurveData me, FBFloat pa
   return parameter - (fAtParameter / fPrimeAtParameter);
 }
 
+// Whether a point could lie on the curve, to within threshold, going by the curve's bounding box
+//  and fat line. Cheap enough to rule most points out before projecting them onto the curve.
+static bool FBBezierCurveDataMightContainPoint(FBBezierCurveData me, FBPoint point, FBFloat threshold) {
+  FBRect boundingRect = FBBezierCurveDataBoundingRect(&me);
+  if (point.x < FBMinX(boundingRect) - threshold || point.x > FBMaxX(boundingRect) + threshold
+      || point.y < FBMinY(boundingRect) - threshold || point.y > FBMaxY(boundingRect) + threshold) {
+    return false;
+  }
+  if (FBArePointsClose(me.endPoint1, me.endPoint2)) {
+    return true; // no fat line to test against
+  }
+  FBRange fatLineBounds = {};
+  FBNormalizedLine fatLine = FBBezierCurveDataRegularFatLineBounds(me, &fatLineBounds);
+  FBFloat distance = FBNormalizedLineDistanceFromPoint(fatLine, point);
+  return distance >= fatLineBounds.minimum - threshold && distance <= fatLineBounds.maximum + threshold;
+}
+
+// Finds the parameter of a point that lies on the curve, to within threshold
+static bool FBBezierCurveDataParameterOfPoint(FBBezierCurveData me, FBPoint point, FBFloat threshold,
+                                              FBFloat *parameter) {
+  if (FBArePointsCloseWithOptions(point, me.endPoint1, threshold)) {
+    *parameter = 0.0;
+    return true;
+  }
+  if (FBArePointsCloseWithOptions(point, me.endPoint2, threshold)) {
+    *parameter = 1.0;
+    return true;
+  }
+  if (!FBBezierCurveDataMightContainPoint(me, point, threshold)) {
+    return false;
+  }
+
+  // Start Newton's method from the closest of a few samples. Missing a point here only costs the
+  //  shortcut, since clipping still finds the overlap.
+  static const size_t FBSampleCount = 4;
+  FBFloat closestParameter = 0.0;
+  FBFloat closestDistance = FBDistanceBetweenPoints(me.endPoint1, point);
+  FBFloat longestStep = 0.0;
+  FBPoint previousSample = me.endPoint1;
+  for (size_t i = 1; i <= FBSampleCount; i++) {
+    FBFloat sampleParameter = (FBFloat)i / FBSampleCount;
+    FBPoint sample = FBBezierCurveDataPointAtParameter(me, sampleParameter, nullptr, nullptr);
+    FBFloat distance = FBDistanceBetweenPoints(sample, point);
+    if (distance < closestDistance) {
+      closestDistance = distance;
+      closestParameter = sampleParameter;
+    }
+    longestStep = std::max(longestStep, FBDistanceBetweenPoints(sample, previousSample));
+    previousSample = sample;
+  }
+  if (closestDistance > longestStep + threshold) {
+    return false; // too far from every sample to be between two of them
+  }
+  for (size_t i = 0; i < 4; i++) {
+    closestParameter = std::clamp(FBBezierCurveDataRefineParameter(me, closestParameter, point), 0.0, 1.0);
+  }
+  FBPoint closestPoint = FBBezierCurveDataPointAtParameter(me, closestParameter, nullptr, nullptr);
+  if (!FBArePointsCloseWithOptions(closestPoint, point, threshold)) {
+    return false;
+  }
+  *parameter = closestParameter;
+  return true;
+}
+
+// Coincident curves never converge under clipping, so catch them before it starts. Where two
+//  curves share a section, each end of that section is an end point of one of the curves that
+//  lies on the other. Find those, then compare the two sections' control points.
+static bool FBBezierCurveDataCheckForCoincidentCurves(FBBezierCurveData me, FBBezierCurveData curve,
+                                                      std::shared_ptr<FBBezierIntersectRange> *intersectRange,
+                                                      FBRange *usRange, FBRange *themRange,
+                                                      std::shared_ptr<const FBBezierCurve> originalUs,
+                                                      std::shared_ptr<const FBBezierCurve> originalThem) {
+  static const FBFloat threshold = 1e-4;
+
+  if (me.isStraightLine != curve.isStraightLine || FBBezierCurveDataIsPoint(&me)
+      || FBBezierCurveDataIsPoint(&curve)) {
+    return false;
+  }
+
+  // The ends of the shared section, as parameters on both curves. Give up as soon as too few end
+  //  points are left to find two.
+  struct {
+    FBPoint point;
+    bool isOurs;
+    FBFloat parameter;
+  } endPoints[4] = {{me.endPoint1, true, 0.0},
+                    {me.endPoint2, true, 1.0},
+                    {curve.endPoint1, false, 0.0},
+                    {curve.endPoint2, false, 1.0}};
+  FBPoint firstEnd = {};
+  FBFloat usParameters[2] = {};
+  FBFloat themParameters[2] = {};
+  size_t endCount = 0;
+  for (size_t i = 0; i < 4 && endCount < 2; i++) {
+    const auto &endPoint = endPoints[i];
+    if (endCount > 0 && FBArePointsCloseWithOptions(endPoint.point, firstEnd, threshold)) {
+      continue; // a vertex the curves share
+    }
+    FBFloat parameter = 0.0;
+    if (!FBBezierCurveDataParameterOfPoint(endPoint.isOurs ? curve : me, endPoint.point, threshold, &parameter)) {
+      if (endCount + (3 - i) < 2) {
+        return false;
+      }
+      continue;
+    }
+    firstEnd = endCount == 0 ? endPoint.point : firstEnd;
+    usParameters[endCount] = endPoint.isOurs ? endPoint.parameter : parameter;
+    themParameters[endCount] = endPoint.isOurs ? parameter : endPoint.parameter;
+    endCount++;
+  }
+  if (endCount < 2) {
+    return false; // at most a single shared point
+  }
+
+  FBRange usSectionRange = FBRangeMake(std::min(usParameters[0], usParameters[1]),
+                                       std::max(usParameters[0], usParameters[1]));
+  FBRange themSectionRange = FBRangeMake(std::min(themParameters[0], themParameters[1]),
+                                         std::max(themParameters[0], themParameters[1]));
+  FBBezierCurveData usSection = FBBezierCurveDataSubcurveWithRange(me, usSectionRange);
+  FBBezierCurveData themSection = FBBezierCurveDataSubcurveWithRange(curve, themSectionRange);
+  if (!FBBezierCurveDataIsEqualWithOptions(usSection, themSection, threshold)
+      && !FBBezierCurveDataIsEqualWithOptions(usSection, FBBezierCurveDataReversed(themSection), threshold)) {
+    return false;
+  }
+
+  *usRange = usSectionRange;
+  *themRange = themSectionRange;
+  return FBBezierCurveDataCheckForOverlapRange(me, intersectRange, usRange, themRange, originalUs, originalThem,
+                                               usSection, themSection);
+}
+
 static std::shared_ptr<FBBezierIntersectRange>
 FBBezierCurveDataMergeIntersectRange(std::shared_ptr<FBBezierIntersectRange> intersectRange,
                                      std::shared_ptr<FBBezierIntersectRange> otherIntersectRange) {
@@ -1447,6 +1576,125 @@ FBBezierCurveDataMergeIntersectRange(std::shared_ptr<FBBezierIntersectRange> int
   return intersectRange;
 }
 
+// One coordinate of a bezier curve, as a cubic polynomial in power form
+struct FBCubicPolynomial {
+  FBFloat a0 = 0.0;
+  FBFloat a1 = 0.0;
+  FBFloat a2 = 0.0;
+  FBFloat a3 = 0.0;
+
+  FBFloat value(FBFloat t) const { return ((a3 * t + a2) * t + a1) * t + a0; }
+  FBFloat derivative(FBFloat t) const { return (3.0 * a3 * t + 2.0 * a2) * t + a1; }
+};
+
+static FBCubicPolynomial FBCubicPolynomialMake(FBFloat p0, FBFloat p1, FBFloat p2, FBFloat p3) {
+  return FBCubicPolynomial{.a0 = p0,
+                           .a1 = 3.0 * (p1 - p0),
+                           .a2 = 3.0 * (p0 - 2.0 * p1 + p2),
+                           .a3 = p3 - p0 + 3.0 * (p1 - p2)};
+}
+
+// Finds the one root of polynomial - value on [minimum, maximum], where the polynomial is
+//  monotone, if the ends bracket one. Newton's method, falling back to bisection whenever a step
+//  would leave the bracket.
+static bool FBFindMonotoneRoot(const FBCubicPolynomial &polynomial, FBFloat value, FBFloat minimum, FBFloat maximum,
+                               FBFloat *root) {
+  static const size_t FBMaximumIterations = 64;
+
+  FBFloat minimumValue = polynomial.value(minimum) - value;
+  FBFloat maximumValue = polynomial.value(maximum) - value;
+  if (minimumValue == 0.0) {
+    *root = minimum;
+    return true;
+  }
+  if (maximumValue == 0.0) {
+    *root = maximum;
+    return true;
+  }
+  if ((minimumValue < 0.0) == (maximumValue < 0.0)) {
+    return false;
+  }
+
+  FBFloat t = minimum - minimumValue * (maximum - minimum) / (maximumValue - minimumValue);
+  for (size_t iteration = 0; iteration < FBMaximumIterations; iteration++) {
+    FBFloat difference = polynomial.value(t) - value;
+    if (difference == 0.0) {
+      break;
+    }
+    if ((difference < 0.0) == (minimumValue < 0.0)) {
+      minimum = t;
+      minimumValue = difference;
+    } else {
+      maximum = t;
+    }
+    FBFloat slope = polynomial.derivative(t);
+    FBFloat next = slope != 0.0 ? t - difference / slope : minimum;
+    if (!(next > minimum && next < maximum)) {
+      next = (minimum + maximum) / 2.0;
+    }
+    if (next == t) {
+      break;
+    }
+    t = next;
+  }
+  *root = t;
+  return true;
+}
+
+// Finds the parameters in [0, 1] where the polynomial equals value, in increasing order. The
+//  polynomial is split at its extremes into at most three monotone pieces, each of which holds at
+//  most one root. Returns the number of roots.
+static size_t FBFindCubicRoots(const FBCubicPolynomial &polynomial, FBFloat value, FBFloat roots[3]) {
+  // The extremes are the roots of the derivative, a quadratic. A cubic elevated from a quadratic
+  //  has a leading coefficient that's only rounding noise, where the textbook formula cancels
+  //  catastrophically, so the roots are taken as q / a and c / q instead, neither of which
+  //  subtracts nearly equal values. With a negligible next to b the derivative is linear.
+  FBFloat splits[4] = {0.0};
+  size_t splitCount = 1;
+  FBFloat a = 3.0 * polynomial.a3;
+  FBFloat b = 2.0 * polynomial.a2;
+  FBFloat c = polynomial.a1;
+  FBFloat extremes[2] = {};
+  size_t extremeCount = 0;
+  if (std::abs(a) <= std::numeric_limits<FBFloat>::epsilon() * std::abs(b)) {
+    if (b != 0.0) {
+      extremes[extremeCount++] = -c / b;
+    }
+  } else {
+    FBFloat discriminant = b * b - 4.0 * a * c;
+    if (discriminant >= 0.0) {
+      FBFloat q = -(b + std::copysign(std::sqrt(discriminant), b)) / 2.0;
+      extremes[extremeCount++] = q / a;
+      if (q != 0.0) {
+        extremes[extremeCount++] = c / q;
+      }
+      if (extremeCount == 2 && extremes[0] > extremes[1]) {
+        std::swap(extremes[0], extremes[1]);
+      }
+    }
+  }
+  for (size_t i = 0; i < extremeCount; i++) {
+    if (extremes[i] > splits[splitCount - 1] && extremes[i] < 1.0) {
+      splits[splitCount++] = extremes[i];
+    }
+  }
+  splits[splitCount++] = 1.0;
+
+  size_t rootCount = 0;
+  for (size_t i = 0; i + 1 < splitCount; i++) {
+    FBFloat root = 0.0;
+    if (!FBFindMonotoneRoot(polynomial, value, splits[i], splits[i + 1], &root)) {
+      continue;
+    }
+    // Neighboring pieces both find a root sitting on the extreme between them
+    if (rootCount > 0 && roots[rootCount - 1] == root) {
+      continue;
+    }
+    roots[rootCount++] = root;
+  }
+  return rootCount;
+}
+
 static bool FBBezierCurveDataIntersectionsWithStraightLines(FBBezierCurveData me, FBBezierCurveData curve,
                                                             FBRange *usRange, FBRange *themRange,
                                                             std::shared_ptr<const FBBezierCurve> originalUs,
@@ -1456,23 +1704,98 @@ static bool FBBezierCurveDataIntersectionsWithStraightLines(FBBezierCurveData me
     return false;
   }
 
-  FBPoint intersectionPoint = FBZeroPoint;
-  bool intersects = FBLinesIntersect(me.endPoint1, me.endPoint2, curve.endPoint1, curve.endPoint2, &intersectionPoint);
-  if (!intersects) {
-    return false;
+  // Each parameter is where the signed distance of the line's end points from the other line
+  //  crosses zero, which the orientations of the end points give directly. The orientations have
+  //  exact signs, so an end point lying on the other line lands exactly on a parameter of 0 or 1.
+  FBFloat meStart = FBOrientation(curve.endPoint1, curve.endPoint2, me.endPoint1);
+  FBFloat meEnd = FBOrientation(curve.endPoint1, curve.endPoint2, me.endPoint2);
+  FBFloat curveStart = FBOrientation(me.endPoint1, me.endPoint2, curve.endPoint1);
+  FBFloat curveEnd = FBOrientation(me.endPoint1, me.endPoint2, curve.endPoint2);
+  if (meStart == meEnd || curveStart == curveEnd) {
+    return false; // parallel
   }
 
-  FBFloat meParameter = FBParameterOfPointOnLine(me.endPoint1, me.endPoint2, intersectionPoint);
+  FBFloat meParameter = meStart == 0.0 ? 0.0 : (meEnd == 0.0 ? 1.0 : meStart / (meStart - meEnd));
   if (FBIsValueLessThan(meParameter, 0.0) || FBIsValueGreaterThan(meParameter, 1.0)) {
     return false;
   }
 
-  FBFloat curveParameter = FBParameterOfPointOnLine(curve.endPoint1, curve.endPoint2, intersectionPoint);
+  FBFloat curveParameter = curveStart == 0.0 ? 0.0 : (curveEnd == 0.0 ? 1.0 : curveStart / (curveStart - curveEnd));
   if (FBIsValueLessThan(curveParameter, 0.0) || FBIsValueGreaterThan(curveParameter, 1.0)) {
     return false;
   }
 
-  outputBlock(std::make_shared<FBBezierIntersection>(originalUs, meParameter, originalThem, curveParameter), stop);
+  outputBlock(FBMakeShared<FBBezierIntersection>(originalUs, meParameter, originalThem, curveParameter), stop);
+
+  return true;
+}
+
+// Intersects a straight line with a curve that isn't one. The signed distance of the curve from
+//  the line is a cubic polynomial in the curve's parameter, so the curve crosses the line wherever
+//  that polynomial has a root. Returns false, having found nothing, when the curve runs along the
+//  line, which is an overlap that has to be left to clipping.
+static bool FBBezierCurveDataIntersectionsWithLineAndCurve(FBBezierCurveData line, FBBezierCurveData curve,
+                                                           bool isLineUs,
+                                                           std::shared_ptr<const FBBezierCurve> originalUs,
+                                                           std::shared_ptr<const FBBezierCurve> originalThem,
+                                                           FBCurveIntersectionBlock outputBlock, bool *stop) {
+  FBPoint direction = FBSubtractPoint(line.endPoint2, line.endPoint1);
+  FBFloat length = FBPointLength(direction);
+  if (length == 0.0) {
+    return false;
+  }
+
+  // Orientations have exact signs, so an end point of the curve lying on the line has a distance
+  //  of exactly zero. End points within the closeness threshold are snapped onto the line too.
+  FBFloat distances[4] = {FBOrientation(line.endPoint1, line.endPoint2, curve.endPoint1),
+                          FBOrientation(line.endPoint1, line.endPoint2, curve.controlPoint1),
+                          FBOrientation(line.endPoint1, line.endPoint2, curve.controlPoint2),
+                          FBOrientation(line.endPoint1, line.endPoint2, curve.endPoint2)};
+  bool isAlongLine = true;
+  for (size_t i = 0; i < 4; i++) {
+    bool isOnLine = FBAreValuesClose(distances[i] / length, 0.0);
+    if (isOnLine && (i == 0 || i == 3)) {
+      distances[i] = 0.0;
+    }
+    isAlongLine = isAlongLine && isOnLine;
+  }
+  if (isAlongLine) {
+    return false;
+  }
+  if ((distances[0] > 0.0 && distances[1] > 0.0 && distances[2] > 0.0 && distances[3] > 0.0)
+      || (distances[0] < 0.0 && distances[1] < 0.0 && distances[2] < 0.0 && distances[3] < 0.0)) {
+    return true; // the control hull is strictly on one side
+  }
+
+  FBCubicPolynomial polynomial = FBCubicPolynomialMake(distances[0], distances[1], distances[2], distances[3]);
+  FBFloat roots[4] = {};
+  size_t rootCount = FBFindCubicRoots(polynomial, 0.0, roots);
+
+  // The power form doesn't evaluate exactly to the last distance at 1, so a curve ending on the
+  //  line can come out just short of a root there. Pin it down explicitly.
+  if (distances[3] == 0.0) {
+    if (rootCount > 0 && FBAreValuesClose(roots[rootCount - 1], 1.0)) {
+      roots[rootCount - 1] = 1.0;
+    } else {
+      roots[rootCount++] = 1.0;
+    }
+  }
+
+  FBFloat lengthSquared = FBDotMultiplyPoint(direction, direction);
+  for (size_t i = 0; i < rootCount && !*stop; i++) {
+    FBPoint point = FBBezierCurveDataPointAtParameter(curve, roots[i], nullptr, nullptr);
+    FBFloat lineParameter = FBDotMultiplyPoint(FBSubtractPoint(point, line.endPoint1), direction) / lengthSquared;
+    if (FBIsValueLessThan(lineParameter, 0.0) || FBIsValueGreaterThan(lineParameter, 1.0)) {
+      continue;
+    }
+    lineParameter = std::clamp(lineParameter, 0.0, 1.0);
+
+    if (isLineUs) {
+      outputBlock(FBMakeShared<FBBezierIntersection>(originalUs, lineParameter, originalThem, roots[i]), stop);
+    } else {
+      outputBlock(FBMakeShared<FBBezierIntersection>(originalUs, roots[i], originalThem, lineParameter), stop);
+    }
+  }
 
   return true;
 }
@@ -1519,6 +1842,20 @@ static void FBBezierCurveDataIntersectionsWithBezierCurve(FBBezierCurveData me,
                                                     outputBlock, stop);
     return;
   }
+  // A line against a curve has a closed form solution, but only for the whole curves; once clipping
+  //  has started the subcurves have to stay with it.
+  if (depth == 0 && us.isStraightLine != them.isStraightLine
+      && FBBezierCurveDataIntersectionsWithLineAndCurve(us.isStraightLine ? me : curve, us.isStraightLine ? curve : me,
+                                                        us.isStraightLine, originalUs, originalThem, outputBlock,
+                                                        stop)) {
+    return;
+  }
+
+  if (depth == 0
+      && FBBezierCurveDataCheckForCoincidentCurves(me, curve, intersectRange, usRange, themRange, originalUs,
+                                                   originalThem)) {
+    return;
+  }
 
   FBBezierCurveData originalUsData = originalUs->data();
   FBBezierCurveData originalThemData = originalThem->data();
@@ -1533,6 +1870,8 @@ static void FBBezierCurveDataIntersectionsWithBezierCurve(FBBezierCurveData me,
   while (
       iterations < maxIterations
       && ((iterations == 0) || (!FBRangeHasConverged(*usRange, places) || !FBRangeHasConverged(*themRange, places)))) {
+    FBCountIntersectionWork(&FBIntersectionCounters::clippingIterations);
+
     // Remember what the current range is so we can calculate how much it changed later
     FBRange previousUsRange = *usRange;
     FBRange previousThemRange = *themRange;
@@ -1606,6 +1945,7 @@ static void FBBezierCurveDataIntersectionsWithBezierCurve(FBBezierCurveData me,
         bool range2ConvergedAlready = FBRangeHasConverged(usRange2, places) && FBRangeHasConverged(*themRange, places);
 
         if (!range1ConvergedAlready && !range2ConvergedAlready && depth < maxDepth) {
+          FBCountIntersectionWork(&FBIntersectionCounters::subdivisions);
           // Compute the intersections between the two halves of us and them
           std::shared_ptr<FBBezierIntersectRange> leftIntersectRange = nullptr;
           FBBezierCurveDataIntersectionsWithBezierCurve(us1, them, &usRange1, &themRangeCopy1, originalUs, originalThem,
@@ -1624,6 +1964,9 @@ static void FBBezierCurveDataIntersectionsWithBezierCurve(FBBezierCurveData me,
           }
           return;
         } else {
+          if (!range1ConvergedAlready && !range2ConvergedAlready) {
+            FBCountIntersectionWork(&FBIntersectionCounters::maxDepthReached);
+          }
           didNotSplit = true;
         }
       } else {
@@ -1641,6 +1984,7 @@ static void FBBezierCurveDataIntersectionsWithBezierCurve(FBBezierCurveData me,
         bool range2ConvergedAlready = FBRangeHasConverged(themRange2, places) && FBRangeHasConverged(*usRange, places);
 
         if (!range1ConvergedAlready && !range2ConvergedAlready && depth < maxDepth) {
+          FBCountIntersectionWork(&FBIntersectionCounters::subdivisions);
           // Compute the intersections between the two halves of them and us
           std::shared_ptr<FBBezierIntersectRange> leftIntersectRange = nullptr;
           FBBezierCurveDataIntersectionsWithBezierCurve(us, them1, &usRangeCopy1, &themRange1, originalUs, originalThem,
@@ -1661,6 +2005,9 @@ static void FBBezierCurveDataIntersectionsWithBezierCurve(FBBezierCurveData me,
 
           return;
         } else {
+          if (!range1ConvergedAlready && !range2ConvergedAlready) {
+            FBCountIntersectionWork(&FBIntersectionCounters::maxDepthReached);
+          }
           didNotSplit = true;
         }
       }
@@ -1674,6 +2021,9 @@ static void FBBezierCurveDataIntersectionsWithBezierCurve(FBBezierCurveData me,
 
     iterations++;
   }
+  if (iterations >= maxIterations) {
+    FBCountIntersectionWork(&FBIntersectionCounters::maxIterationsReached);
+  }
 
   // It's possible that one of the curves has converged, but the other hasn't. Since the math
   // becomes wonky once a curve becomes a point,
@@ -1757,7 +2107,7 @@ static void FBBezierCurveDataIntersectionsWithBezierCurve(FBBezierCurveData me,
   // Return the final intersection, which we represent by the original curves and the parameters
   // where they intersect. The parameter values are useful
   //  later in the boolean operations, plus it allows us to do lazy calculations.
-  outputBlock(std::make_shared<FBBezierIntersection>(originalUs, FBRangeAverage(*usRange), originalThem,
+  outputBlock(FBMakeShared<FBBezierIntersection>(originalUs, FBRangeAverage(*usRange), originalThem,
                                                      FBRangeAverage(*themRange)),
               stop);
 }
@@ -1792,7 +2142,7 @@ bool FBBezierCurve::operator==(const FBBezierCurve &other) const {
 
 bool FBBezierCurve::doesHaveIntersections(std::shared_ptr<FBBezierCurve> curve) {
   size_t count = 0;
-  intersectionsWithBezierCurve(curve, nullptr, [&](std::shared_ptr<FBBezierIntersection> intersection, bool *stop) {
+  intersectionsWithBezierCurve(curve, nullptr, [&](const std::shared_ptr<FBBezierIntersection> &intersection, bool *stop) {
     ++count;
     *stop = true; // Only need the one
   });
@@ -1802,12 +2152,17 @@ bool FBBezierCurve::doesHaveIntersections(std::shared_ptr<FBBezierCurve> curve)
 void FBBezierCurve::intersectionsWithBezierCurve(std::shared_ptr<FBBezierCurve> curve,
                                                  std::shared_ptr<FBBezierIntersectRange> *intersectRange,
                                                  FBCurveIntersectionBlock block) const {
+  FBTraceLeafSpan span("intersectionsWithBezierCurve", [&] { return std::format("{} and {}", *this, *curve); });
+  FBCountIntersectionWork(&FBIntersectionCounters::pairsTested);
+
   // For performance reasons, do a quick bounds check to see if these even might intersect
   if (!FBLineBoundsMightOverlap(FBBezierCurveDataBoundingRect(&_data), FBBezierCurveDataBoundingRect(&curve->_data))) {
+    FBCountIntersectionWork(&FBIntersectionCounters::boundingRectRejections);
     return;
   }
 
   if (!FBLineBoundsMightOverlap(FBBezierCurveDataBounds(&_data), FBBezierCurveDataBounds(&curve->_data))) {
+    FBCountIntersectionWork(&FBIntersectionCounters::boundsRejections);
     return;
   }
 
@@ -1818,8 +2173,66 @@ void FBBezierCurve::intersectionsWithBezierCurve(std::shared_ptr<FBBezierCurve>
                                                 intersectRange, 0, block, &stop);
 }
 
+void FBBezierCurve::rayIntersectionsWithBezierCurve(std::shared_ptr<FBBezierCurve> curve,
+                                                    std::shared_ptr<FBBezierIntersectRange> *intersectRange,
+                                                    FBCurveIntersectionBlock block) const {
+  bool isHorizontal = _data.endPoint1.y == _data.endPoint2.y && _data.endPoint1.x != _data.endPoint2.x;
+  bool isVertical = _data.endPoint1.x == _data.endPoint2.x && _data.endPoint1.y != _data.endPoint2.y;
+  if (!_data.isStraightLine || (!isHorizontal && !isVertical)) {
+    intersectionsWithBezierCurve(curve, intersectRange, block);
+    return;
+  }
+
+  // Across is the coordinate that's constant along the ray, along the one that varies
+  const auto &data = curve->data();
+  auto across = [&](FBPoint point) { return isHorizontal ? point.y : point.x; };
+  auto along = [&](FBPoint point) { return isHorizontal ? point.x : point.y; };
+  FBFloat acrossPoints[] = {across(data.endPoint1), across(data.controlPoint1), across(data.controlPoint2),
+                            across(data.endPoint2)};
+  FBFloat rayAcross = across(_data.endPoint1);
+
+  // Quick reject: the curve lies within the hull of its control points
+  auto [acrossMinimum, acrossMaximum] =
+      std::minmax({acrossPoints[0], acrossPoints[1], acrossPoints[2], acrossPoints[3]});
+  if (FBIsValueLessThan(rayAcross, acrossMinimum) || FBIsValueGreaterThan(rayAcross, acrossMaximum)) {
+    return;
+  }
+  if (FBAreValuesClose(acrossMinimum, rayAcross) && FBAreValuesClose(acrossMaximum, rayAcross)) {
+    // The curve runs along the ray, so this is an overlap
+    intersectionsWithBezierCurve(curve, intersectRange, block);
+    return;
+  }
+
+  // An end point within the closeness threshold of the ray is on it, the same as clipping treats
+  //  it, so a ray through a joint finds it at the end of both edges and the deduplication in
+  //  FBBezierContour::intersectionsWithRay() sees it
+  if (FBAreValuesClose(acrossPoints[0], rayAcross)) {
+    acrossPoints[0] = rayAcross;
+  }
+  if (FBAreValuesClose(acrossPoints[3], rayAcross)) {
+    acrossPoints[3] = rayAcross;
+  }
+
+  auto acrossPolynomial = FBCubicPolynomialMake(acrossPoints[0], acrossPoints[1], acrossPoints[2], acrossPoints[3]);
+  auto alongPolynomial = FBCubicPolynomialMake(along(data.endPoint1), along(data.controlPoint1),
+                                               along(data.controlPoint2), along(data.endPoint2));
+  FBFloat rayStart = along(_data.endPoint1);
+  FBFloat rayLength = along(_data.endPoint2) - rayStart;
+
+  FBFloat roots[3] = {};
+  size_t rootCount = FBFindCubicRoots(acrossPolynomial, rayAcross, roots);
+  bool stop = false;
+  for (size_t i = 0; i < rootCount && !stop; i++) {
+    FBFloat rayParameter = (alongPolynomial.value(roots[i]) - rayStart) / rayLength;
+    if (FBIsValueLessThan(rayParameter, 0.0) || FBIsValueGreaterThan(rayParameter, 1.0)) {
+      continue;
+    }
+    block(FBMakeShared<FBBezierIntersection>(shared_from_this(), rayParameter, curve, roots[i]), &stop);
+  }
+}
+
 std::shared_ptr<FBBezierCurve> FBBezierCurve::subcurveWithRange(FBRange range) {
-  return std::make_shared<FBBezierCurve>(FBBezierCurveDataSubcurveWithRange(_data, range));
+  return FBMakeShared<FBBezierCurve>(FBBezierCurveDataSubcurveWithRange(_data, range));
 }
 
 std::tuple<std::shared_ptr<FBBezierCurve>, std::shared_ptr<FBBezierCurve>, std::shared_ptr<FBBezierCurve>>
@@ -1839,12 +2252,12 @@ FBBezierCurve::splitSubcurvesWithRange(FBRange range) const {
   } else {
     FBBezierCurveData leftCurveData = {};
     FBBezierCurveDataPointAtParameter(_data, range.minimum, &leftCurveData, &remainingCurve);
-    leftCurve = std::make_shared<FBBezierCurve>(leftCurveData);
+    leftCurve = FBMakeShared<FBBezierCurve>(leftCurveData);
   }
 
   // Special case  where we start at the end
   if (range.minimum == 1.0) {
-    middleCurve = std::make_shared<FBBezierCurve>(remainingCurve);
+    middleCurve = FBMakeShared<FBBezierCurve>(remainingCurve);
     rightCurve = nullptr;
     return {leftCurve, middleCurve, rightCurve}; // avoid the divide by zero below
   }
@@ -1854,13 +2267,13 @@ FBBezierCurve::splitSubcurvesWithRange(FBRange range) const {
   FBBezierCurveData middleCurveData = {};
   FBBezierCurveData rightCurveData = {};
   FBBezierCurveDataPointAtParameter(remainingCurve, adjustedMaximum, &middleCurveData, &rightCurveData);
-  middleCurve = std::make_shared<FBBezierCurve>(middleCurveData);
-  rightCurve = std::make_shared<FBBezierCurve>(rightCurveData);
+  middleCurve = FBMakeShared<FBBezierCurve>(middleCurveData);
+  rightCurve = FBMakeShared<FBBezierCurve>(rightCurveData);
   return {leftCurve, middleCurve, rightCurve};
 }
 
 std::shared_ptr<FBBezierCurve> FBBezierCurve::reversedCurve() const {
-  return std::make_shared<FBBezierCurve>(FBBezierCurveDataReversed(_data));
+  return FBMakeShared<FBBezierCurve>(FBBezierCurveDataReversed(_data));
 }
 
 std::tuple<FBPoint, std::shared_ptr<FBBezierCurve>, std::shared_ptr<FBBezierCurve>>
@@ -1868,11 +2281,15 @@ FBBezierCurve::pointAtParameter(FBFloat parameter) const {
   FBBezierCurveData leftData = {};
   FBBezierCurveData rightData = {};
   FBPoint point = FBBezierCurveDataPointAtParameter(_data, parameter, &leftData, &rightData);
-  auto leftBezierCurve = std::make_shared<FBBezierCurve>(leftData);
-  auto rightBezierCurve = std::make_shared<FBBezierCurve>(rightData);
+  auto leftBezierCurve = FBMakeShared<FBBezierCurve>(leftData);
+  auto rightBezierCurve = FBMakeShared<FBBezierCurve>(rightData);
   return {point, leftBezierCurve, rightBezierCurve};
 }
 
+FBPoint FBBezierCurve::locationAtParameter(FBFloat parameter) const {
+  return FBBezierCurveDataPointAtParameter(_data, parameter, nullptr, nullptr);
+}
+
 FBFloat FBBezierCurve::refineParameter(FBFloat parameter, FBPoint point) {
   return FBBezierCurveDataRefineParameter(_data, parameter, point);
 }
@@ -1949,7 +2366,7 @@ FBPoint FBBezierCurve::tangentFromLeftOffset(FBFloat offset) const {
   return returnValue;
 }
 
-std::shared_ptr<FBBezierCurve> FBBezierCurve::clone() const { return std::make_shared<FBBezierCurve>(_data); }
+std::shared_ptr<FBBezierCurve> FBBezierCurve::clone() const { return FBMakeShared<FBBezierCurve>(_data); }
 
 // MARK: ********** FBBezierCurve+Edge **********
 
@@ -2028,44 +2445,66 @@ static void FBComputeEdge2RangeTangentCurves(std::shared_ptr<FBBezierCurve> edge
 }
 
 void FBBezierCurve::addCrossing(std::shared_ptr<FBEdgeCrossing> crossing) {
-  // Make sure the crossing can make it back to us, and keep all the crossings sorted
+  // Make sure the crossing can make it back to us. All the crossings found for an edge get sorted
+  //  together the next time they're read.
   crossing->setEdge(shared_from_this());
   _crossings.push_back(crossing);
-  sortCrossings();
+  _crossingsSorted = false;
 }
 
 void FBBezierCurve::removeCrossing(std::shared_ptr<FBEdgeCrossing> crossing) {
-  // Keep the crossings sorted
-  crossing->setEdge(nullptr);
-  _crossings.erase(std::remove(_crossings.begin(), _crossings.end(), crossing), _crossings.end());
+  // Leave a tombstone in the crossing's slot so the others keep their order and indices
   sortCrossings();
+  if (crossing->index() < _crossings.size() && _crossings[crossing->index()] == crossing) {
+    _crossings[crossing->index()] = nullptr;
+    _removedCrossingCount++;
+  }
+  crossing->setEdge(nullptr);
 }
 
-void FBBezierCurve::removeAllCrossings() { _crossings.clear(); }
+void FBBezierCurve::removeAllCrossings() {
+  _crossings.clear();
+  _crossingsSorted = true;
+  _removedCrossingCount = 0;
+}
+
+std::vector<std::shared_ptr<FBEdgeCrossing>> FBBezierCurve::crossings() const {
+  sortCrossings();
+  std::vector<std::shared_ptr<FBEdgeCrossing>> crossings;
+  crossings.reserve(_crossings.size() - _removedCrossingCount);
+  for (const auto &crossing : _crossings) {
+    if (crossing != nullptr) {
+      crossings.push_back(crossing);
+    }
+  }
+  return crossings;
+}
 
 std::shared_ptr<FBBezierCurve> FBBezierCurve::next() {
-  if (_contour.expired()) {
+  auto contour = _contour.lock();
+  if (contour == nullptr) {
     return shared_from_this();
   }
-  auto contour = _contour.lock();
 
-  if (_index >= (contour->edges().size() - 1)) {
-    return contour->edges()[0];
+  auto edges = contour->edges();
+  if (_index >= (edges.size() - 1)) {
+    return edges[0];
   }
 
-  return contour->edges()[_index + 1];
+  return edges[_index + 1];
 }
 std::shared_ptr<FBBezierCurve> FBBezierCurve::previous() {
-  if (_contour.expired()) {
+  auto contour = _contour.lock();
+  if (contour == nullptr) {
     return shared_from_this();
   }
-  auto contour = _contour.lock();
 
+  auto edges = contour->edges();
   if (_index == 0) {
-    return contour->edges()[contour->edges().size() - 1];
+    return edges[edges.size() - 1];
   }
 
-  return contour->edges()[_index - 1];
+  return edges[_index - 1];
 }
 std::shared_ptr<FBBezierCurve> FBBezierCurve::nextNonpoint() {
   auto edge = next();
@@ -2082,12 +2521,15 @@ std::shared_ptr<FBBezierCurve> FBBezierCurve::previousNonpoint() {
   return edge;
 }
 
-bool FBBezierCurve::hasCrossings() const { return _crossings.size() > 0; }
+bool FBBezierCurve::hasCrossings() const { return _crossings.size() > _removedCrossingCount; }
 
-void FBBezierCurve::crossingsWithBlock(
-    std::function<void(std::shared_ptr<FBEdgeCrossing> crossing, bool *stop)> block) {
+void FBBezierCurve::crossingsWithBlock(FBEdgeCrossingBlock block) {
+  sortCrossings();
   bool stop = false;
   for (const auto &crossing : _crossings) {
+    if (crossing == nullptr) {
+      continue;
+    }
     block(crossing, &stop);
     if (stop) {
       break;
@@ -2095,11 +2537,14 @@ void FBBezierCurve::crossingsWithBlock(
   }
 }
 
-void FBBezierCurve::crossingsCopyWithBlock(
-    std::function<void(std::shared_ptr<FBEdgeCrossing> crossing, bool *stop)> block) {
+void FBBezierCurve::crossingsCopyWithBlock(FBEdgeCrossingBlock block) {
+  sortCrossings();
   bool stop = false;
   auto crossingsCopy = _crossings;
   for (const auto &crossing : crossingsCopy) {
+    if (crossing == nullptr) {
+      continue;
+    }
     block(crossing, &stop);
     if (stop) {
       break;
@@ -2108,24 +2553,27 @@ void FBBezierCurve::crossingsCopyWithBlock(
 }
 
 std::shared_ptr<FBEdgeCrossing> FBBezierCurve::nextCrossing(std::shared_ptr<FBEdgeCrossing> crossing) {
-  if (crossing->index() >= (_crossings.size() - 1)) {
-    return nullptr;
+  sortCrossings();
+  for (size_t index = crossing->index() + 1; index < _crossings.size(); index++) {
+    if (_crossings[index] != nullptr) {
+      return _crossings[index];
+    }
   }
-
-  return _crossings[crossing->index() + 1];
+  return nullptr;
 }
 
 std::shared_ptr<FBEdgeCrossing> FBBezierCurve::previousCrossing(std::shared_ptr<FBEdgeCrossing> crossing) {
-  if (crossing->index() == 0) {
-    return nullptr;
+  sortCrossings();
+  for (size_t index = crossing->index(); index > 0; index--) {
+    if (_crossings[index - 1] != nullptr) {
+      return _crossings[index - 1];
+    }
   }
-
-  return _crossings[crossing->index() - 1];
+  return nullptr;
 }
 
-void FBBezierCurve::intersectingEdgesWithBlock(
-    std::function<void(std::shared_ptr<FBBezierCurve> intersectingEdge)> block) {
-  crossingsWithBlock([&](std::shared_ptr<FBEdgeCrossing> crossing, bool *stop) {
+void FBBezierCurve::intersectingEdgesWithBlock(FBIntersectingEdgeBlock block) {
+  crossingsWithBlock([&](const std::shared_ptr<FBEdgeCrossing> &crossing, bool *stop) {
     if (crossing->isSelfCrossing()) {
       return; // Right now skip over self intersecting crossings
     }
@@ -2134,9 +2582,8 @@ void FBBezierCurve::intersectingEdgesWithBlock(
   });
 }
 
-void FBBezierCurve::selfIntersectingEdgesWithBlock(
-    std::function<void(std::shared_ptr<FBBezierCurve> intersectingEdge)> block) {
-  crossingsWithBlock([&](std::shared_ptr<FBEdgeCrossing> crossing, bool *stop) {
+void FBBezierCurve::selfIntersectingEdgesWithBlock(FBIntersectingEdgeBlock block) {
+  crossingsWithBlock([&](const std::shared_ptr<FBEdgeCrossing> &crossing, bool *stop) {
     if (!crossing->isSelfCrossing()) {
       return; // Only want the self intersecting crossings
     }
@@ -2146,17 +2593,23 @@ void FBBezierCurve::selfIntersectingEdgesWithBlock(
 }
 
 std::shared_ptr<FBEdgeCrossing> FBBezierCurve::firstCrossing() const {
-  if (_crossings.size() == 0) {
-    return nullptr;
+  sortCrossings();
+  for (const auto &crossing : _crossings) {
+    if (crossing != nullptr) {
+      return crossing;
+    }
   }
-  return _crossings[0];
+  return nullptr;
 }
 
 std::shared_ptr<FBEdgeCrossing> FBBezierCurve::lastCrossing() const {
-  if (_crossings.size() == 0) {
-    return nullptr;
+  sortCrossings();
+  for (auto crossing = _crossings.rbegin(); crossing != _crossings.rend(); ++crossing) {
+    if (*crossing != nullptr) {
+      return *crossing;
+    }
   }
-  return _crossings[_crossings.size() - 1];
+  return nullptr;
 }
 
 std::shared_ptr<FBEdgeCrossing> FBBezierCurve::firstNonselfCrossing() const {
@@ -2178,7 +2631,7 @@ std::shared_ptr<FBEdgeCrossing> FBBezierCurve::lastNonselfCrossing() const {
 bool FBBezierCurve::hasNonselfCrossings() const {
   bool hasNonself = false;
   for (const auto &crossing : _crossings) {
-    if (!crossing->isSelfCrossing()) {
+    if (crossing != nullptr && !crossing->isSelfCrossing()) {
       hasNonself = true;
       break;
     }
@@ -2268,10 +2721,21 @@ bool FBBezierCurve::crossesEdge(std::shared_ptr<FBBezierCurve> edge2,
   return FBTangentsCross(edge1Tangents, edge2Tangents);
 }
 
-void FBBezierCurve::sortCrossings() {
-  // Sort by the "order" of the crossing, then assign indices so next and previous work correctly.
-  std::sort(_crossings.begin(), _crossings.end(),
-            [](const auto &crossing1, const auto &crossing2) { return crossing1->order() < crossing2->order(); });
+void FBBezierCurve::sortCrossings() const {
+  if (_crossingsSorted) {
+    return;
+  }
+  // Drop the tombstones, sort by the "order" of the crossing, then assign indices so next and
+  //  previous work correctly. The sort is stable so crossings at the same parameter stay in the
+  //  order they were found.
+  if (_removedCrossingCount > 0) {
+    _crossings.erase(std::remove(_crossings.begin(), _crossings.end(), nullptr), _crossings.end());
+    _removedCrossingCount = 0;
+  }
+  std::stable_sort(_crossings.begin(), _crossings.end(), [](const auto &crossing1, const auto &crossing2) {
+    return crossing1->order() < crossing2->order();
+  });
+  _crossingsSorted = true;
   size_t index = 0;
   for (auto &crossing : _crossings) {
     crossing->setIndex(index++);
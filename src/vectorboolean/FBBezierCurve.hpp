@@ -27,20 +27,24 @@ OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 #include "FBCommon.hpp"
+#include "FBFunctionRef.hpp"
 #include "FBGeometry.hpp"
 
-#include <functional>
 #include <sstream>
 
 namespace fb {
 
 class FBEdgeCrossing;
 class FBBezierContour;
+class FBBezierCurve;
 class FBBezierIntersection;
 class FBBezierIntersectRange;
 struct FBBezierCurveLocation;
 
-using FBCurveIntersectionBlock = std::function<void(std::shared_ptr<FBBezierIntersection> intersection, bool *stop)>;
+using FBCurveIntersectionBlock =
+    FBFunctionRef<void(const std::shared_ptr<FBBezierIntersection> &intersection, bool *stop)>;
+using FBEdgeCrossingBlock = FBFunctionRef<void(const std::shared_ptr<FBEdgeCrossing> &crossing, bool *stop)>;
+using FBIntersectingEdgeBlock = FBFunctionRef<void(const std::shared_ptr<FBBezierCurve> &intersectingEdge)>;
 
 typedef struct FBBezierCurveLocation {
   FBFloat parameter;
@@ -64,14 +68,18 @@ struct FBBezierCurveData {
 // bezier path, and is where the intersection calculation happens
 class FBBezierCurve : public std::enable_shared_from_this<FBBezierCurve> {
   mutable FBBezierCurveData _data;
-  std::vector<std::shared_ptr<FBEdgeCrossing>> _crossings; // sorted by parameter of the intersection
+  // Crossings are appended as they're found and sorted by parameter the first time they're read.
+  //  Removed crossings leave a nullptr behind until the next sort compacts them away.
+  mutable std::vector<std::shared_ptr<FBEdgeCrossing>> _crossings;
+  mutable bool _crossingsSorted = true;
+  mutable size_t _removedCrossingCount = 0;
   std::weak_ptr<FBBezierContour> _contour;
-  size_t _index;
-  bool _startShared;
+  size_t _index = 0;
+  bool _startShared = false;
 
 protected:
   FBFloat refineParameter(FBFloat parameter, FBPoint point);
-  void sortCrossings();
+  void sortCrossings() const;
 
 public:
   FBBezierCurve(FBPoint startPoint, FBPoint endPoint, std::shared_ptr<FBBezierContour> contour = nullptr);
@@ -94,8 +102,17 @@ public:
   void intersectionsWithBezierCurve(std::shared_ptr<FBBezierCurve> curve,
                                     std::shared_ptr<FBBezierIntersectRange> *intersectRange,
                                     FBCurveIntersectionBlock block) const;
+  // The same as intersectionsWithBezierCurve() when this curve is a horizontal or vertical line,
+  //  like the rays the containment tests cast, but solves x(t) = c or y(t) = c for the other curve
+  //  directly instead of clipping. A curve lying along the line, and any ray that isn't axis
+  //  aligned, go through intersectionsWithBezierCurve().
+  void rayIntersectionsWithBezierCurve(std::shared_ptr<FBBezierCurve> curve,
+                                       std::shared_ptr<FBBezierIntersectRange> *intersectRange,
+                                       FBCurveIntersectionBlock block) const;
   std::tuple<FBPoint, std::shared_ptr<FBBezierCurve>, std::shared_ptr<FBBezierCurve>>
   pointAtParameter(FBFloat parameter) const;
+  // The point of pointAtParameter(), without making the two halves of the curve
+  FBPoint locationAtParameter(FBFloat parameter) const;
   std::shared_ptr<FBBezierCurve> subcurveWithRange(FBRange range);
   std::tuple<std::shared_ptr<FBBezierCurve>, std::shared_ptr<FBBezierCurve>, std::shared_ptr<FBBezierCurve>>
   splitSubcurvesWithRange(FBRange range) const;
@@ -111,7 +128,7 @@ public:
   FBBezierCurveLocation closestLocationToPoint(FBPoint point) const;
   std::shared_ptr<FBBezierCurve> reversedCurve() const;
   std::shared_ptr<FBBezierCurve> clone() const;
-  std::vector<std::shared_ptr<FBEdgeCrossing>> crossings() const { return _crossings; }
+  std::vector<std::shared_ptr<FBEdgeCrossing>> crossings() const;
 
   const FBBezierCurveData &data() const { return _data; }
   FBBezierCurveData &data() { return _data; }
@@ -138,14 +155,14 @@ public:
 
   bool hasNonselfCrossings() const;
 
-  void crossingsWithBlock(std::function<void(std::shared_ptr<FBEdgeCrossing> crossing, bool *stop)> block);
-  void crossingsCopyWithBlock(std::function<void(std::shared_ptr<FBEdgeCrossing> crossing, bool *stop)> block);
+  void crossingsWithBlock(FBEdgeCrossingBlock block);
+  void crossingsCopyWithBlock(FBEdgeCrossingBlock block);
 
   std::shared_ptr<FBEdgeCrossing> nextCrossing(std::shared_ptr<FBEdgeCrossing> crossing);
   std::shared_ptr<FBEdgeCrossing> previousCrossing(std::shared_ptr<FBEdgeCrossing> crossing);
 
-  void intersectingEdgesWithBlock(std::function<void(std::shared_ptr<FBBezierCurve> intersectingEdge)> block);
-  void selfIntersectingEdgesWithBlock(std::function<void(std::shared_ptr<FBBezierCurve> intersectingEdge)> block);
+  void intersectingEdgesWithBlock(FBIntersectingEdgeBlock block);
+  void selfIntersectingEdgesWithBlock(FBIntersectingEdgeBlock block);
 
   bool isStartShared() const { return _startShared; }
   void setStartShared(bool startShared) { _startShared = startShared; }
@@ -26,14 +26,22 @@ OTHER DEALINGS IN THE SOFTWARE.
 
 #include "FBBezierGraph.hpp"
 
+#include "FBArena.hpp"
 #include "FBBezierContour.hpp"
 #include "FBBezierCurve.hpp"
 #include "FBBezierIntersectRange.hpp"
 #include "FBBezierPath.hpp"
+#include "FBBooleanStats.hpp"
+#include "FBBoundsTree.hpp"
+#include "FBConcurrency.hpp"
+#include "FBContourAdjacency.hpp"
 #include "FBContourOverlap.hpp"
 #include "FBCurveLocation.hpp"
 #include "FBEdgeCrossing.hpp"
+#include "FBEdgeTable.hpp"
+#include "FBTrace.hpp"
 
+#include <numeric>
 #include <sstream>
 #include <format>
 
@@ -55,30 +63,153 @@ namespace fb {
 //  The last part of each boolean operation deals with what do with contours
 //  in each graph that don't intersect any other contours.
 //
-// The exclusive or boolean op is implemented in terms of union, intersect,
-//  and difference. More specifically it subtracts the intersection of both
-//  graphs from the union of both graphs.
+// The exclusive or boolean op walks the same crossings twice, once for the
+//  union of both graphs and once for their intersection, and returns the
+//  union with the intersection as holes in it.
 //
 
-std::shared_ptr<FBBezierGraph> FBBezierGraph::unionWithBezierGraph(std::shared_ptr<FBBezierGraph> graph) {
+// The XOR of two graphs, from their union and intersect parts: the union with the intersect as holes
+//  in it. A contour that doesn't cross anything can end up in both parts, e.g. when the graphs have
+//  equivalent contours. Being in both the union and the intersect means it's not in the XOR, so
+//  it's left out altogether.
+static std::shared_ptr<FBBezierGraph> FBExclusiveOrOfParts(std::shared_ptr<FBBezierGraph> allParts,
+                                                           std::shared_ptr<FBBezierGraph> intersectingParts) {
+  std::vector<FBBezierContour *> intersectingContours;
+  intersectingContours.reserve(intersectingParts->contours().size());
+  for (const auto &contour : intersectingParts->contours()) {
+    intersectingContours.push_back(contour.get());
+  }
+  std::sort(intersectingContours.begin(), intersectingContours.end());
+  std::vector<FBBezierContour *> sharedContours;
+
+  auto result = FBMakeShared<FBBezierGraph>();
+  for (const auto &contour : allParts->contours()) {
+    if (std::binary_search(intersectingContours.begin(), intersectingContours.end(), contour.get())) {
+      sharedContours.push_back(contour.get());
+    } else {
+      result->addContour(contour);
+    }
+  }
+  std::sort(sharedContours.begin(), sharedContours.end());
+  for (const auto &contour : intersectingParts->contours()) {
+    if (!std::binary_search(sharedContours.begin(), sharedContours.end(), contour.get())) {
+      result->addContour(contour);
+    }
+  }
+  return result;
+}
+
+// Pairs up the nonintersecting contours that are equivalent the way checking every pair in order
+//  would: each of our contours takes the first of their contours it's equivalent to that hasn't
+//  been taken yet. The pairs are removed from both lists and returned. Their contours are listed in
+//  graph order, which is adjacency index order, so an equivalent contour is looked up by binary
+//  search rather than by scanning.
+static std::vector<std::pair<std::shared_ptr<FBBezierContour>, std::shared_ptr<FBBezierContour>>>
+FBPairEquivalentContours(std::vector<std::shared_ptr<FBBezierContour>> &ourContours,
+                         std::vector<std::shared_ptr<FBBezierContour>> &theirContours) {
+  std::vector<std::pair<std::shared_ptr<FBBezierContour>, std::shared_ptr<FBBezierContour>>> pairs;
+  std::vector<bool> ourPaired(ourContours.size(), false);
+  std::vector<bool> theirPaired(theirContours.size(), false);
+  for (size_t ourIndex = 0; ourIndex < ourContours.size(); ourIndex++) {
+    size_t theirIndex = theirContours.size();
+    ourContours[ourIndex]->equivalentContoursWithBlock([&](const std::shared_ptr<FBBezierContour> &contour) {
+      auto position = std::lower_bound(theirContours.begin(), theirContours.end(), contour->adjacencyIndex(),
+                                       [](const auto &theirContour, size_t adjacencyIndex) {
+                                         return theirContour->adjacencyIndex() < adjacencyIndex;
+                                       });
+      auto index = static_cast<size_t>(position - theirContours.begin());
+      if (position != theirContours.end() && *position == contour && !theirPaired[index]) {
+        theirIndex = std::min(theirIndex, index);
+      }
+    });
+    if (theirIndex == theirContours.size()) {
+      continue;
+    }
+    pairs.push_back({ourContours[ourIndex], theirContours[theirIndex]});
+    ourPaired[ourIndex] = true;
+    theirPaired[theirIndex] = true;
+  }
+
+  // Remove the paired contours from the inputs so they aren't processed later
+  auto removePaired = [](std::vector<std::shared_ptr<FBBezierContour>> &contours, const std::vector<bool> &paired) {
+    size_t kept = 0;
+    for (size_t index = 0; index < contours.size(); index++) {
+      if (!paired[index]) {
+        contours[kept++] = std::move(contours[index]);
+      }
+    }
+    contours.resize(kept);
+  };
+  removePaired(ourContours, ourPaired);
+  removePaired(theirContours, theirPaired);
+  return pairs;
+}
+
+// The first part shared by all the boolean operations: insert FBEdgeCrossings into both graphs
+//  where they cross each other or themselves, then clean them up.
+void FBBezierGraph::insertAndCleanupCrossingsWithBezierGraph(std::shared_ptr<FBBezierGraph> graph,
+                                                             FBBooleanStats *stats) {
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::insertCrossings, "insertCrossings");
+    insertCrossingsWithBezierGraph(graph);
+  }
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::insertSelfCrossings, "insertSelfCrossings");
+    insertSelfCrossings();
+    graph->insertSelfCrossings();
+  }
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::cleanupCrossings, "cleanupCrossings");
+    cleanupCrossingsWithBezierGraph(graph);
+    // The crossings are final now, so record which contours they connect
+    _contourAdjacency = FBMakeShared<FBContourAdjacency>(_contours, graph->_contours);
+    graph->_contourAdjacency = _contourAdjacency;
+  }
+
+  if (stats == nullptr) {
+    return;
+  }
+  for (const auto &operand : {shared_from_this(), graph}) {
+    for (const auto &contour : operand->contours()) {
+      stats->contourCount++;
+      stats->edgeCount += contour->edges().size();
+      for (const auto &edge : contour->edges()) {
+        edge->crossingsWithBlock(
+            [&](const std::shared_ptr<FBEdgeCrossing> &crossing, bool *stop) { stats->crossingCount++; });
+      }
+    }
+  }
+}
+
+std::shared_ptr<FBBezierGraph> FBBezierGraph::unionWithBezierGraph(std::shared_ptr<FBBezierGraph> graph,
+                                                                   FBBooleanStats *stats) {
+  FBTraceSpan span("unionWithBezierGraph");
+
   // First insert FBEdgeCrossings into both graphs where the graphs
   //  cross.
-  insertCrossingsWithBezierGraph(graph);
-  insertSelfCrossings();
-  graph->insertSelfCrossings();
-  cleanupCrossingsWithBezierGraph(graph);
+  insertAndCleanupCrossingsWithBezierGraph(graph, stats);
 
   // Handle the parts of the graphs that intersect first. Mark the parts
   //  of the graphs that are outside the other for the final result.
-  markCrossingsAsEntryOrExitWithBezierGraph(graph, false);
-  graph->markCrossingsAsEntryOrExitWithBezierGraph(shared_from_this(), false);
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::markCrossings, "markCrossings");
+    markCrossingsAsEntryOrExitWithBezierGraph(graph, false);
+    graph->markCrossingsAsEntryOrExitWithBezierGraph(shared_from_this(), false);
+  }
 
   // Walk the crossings and actually compute the final result for the intersecting parts
-  auto result = bezierGraphFromIntersections();
+  std::shared_ptr<FBBezierGraph> result;
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::intersections, "intersections");
+    result = bezierGraphFromIntersections();
+  }
 
   // Finally, process the contours that don't cross anything else. They're either
   //  completely contained in another contour, or disjoint.
-  unionNonintersectingPartsIntoGraph(result, graph);
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::nonintersectingContours, "nonintersectingContours");
+    unionNonintersectingPartsIntoGraph(result, graph);
+  }
 
   // Clean up crossings so the graphs can be reused, e.g. XOR will reuse graphs.
   removeCrossings();
@@ -132,51 +263,52 @@ void FBBezierGraph::unionEquivalentNonintersectingContours(
     std::vector<std::shared_ptr<FBBezierContour>> &ourNonintersectingContours,
     std::vector<std::shared_ptr<FBBezierContour>> &theirNonintersectingContours,
     std::vector<std::shared_ptr<FBBezierContour>> &results) {
-  for (std::size_t ourIndex = 0; ourIndex < ourNonintersectingContours.size(); ++ourIndex) {
-    auto ourContour = ourNonintersectingContours[ourIndex];
-    for (std::size_t theirIndex = 0; theirIndex < theirNonintersectingContours.size(); ++theirIndex) {
-      auto theirContour = theirNonintersectingContours[theirIndex];
-
-      if (!ourContour->isEquivalent(theirContour)) {
-        continue;
-      }
-
-      if (ourContour->inside() == theirContour->inside()) {
-        // Redundant, so just remove one of them from the results
-        results.erase(std::remove(results.begin(), results.end(), theirContour), results.end());
-      } else {
-        // One is a hole, one is a fill, so they cancel each other out. Remove both from the results
-        results.erase(std::remove(results.begin(), results.end(), theirContour), results.end());
-        results.erase(std::remove(results.begin(), results.end(), ourContour), results.end());
-      }
-
-      // Remove both from the inputs so they aren't processed later
-      theirNonintersectingContours.erase(theirNonintersectingContours.begin() + theirIndex);
-      ourNonintersectingContours.erase(ourNonintersectingContours.begin() + ourIndex);
-      ourIndex--;
-      break;
+  auto equivalentContours = FBPairEquivalentContours(ourNonintersectingContours, theirNonintersectingContours);
+  std::vector<FBBezierContour *> removedContours;
+  for (const auto &[ourContour, theirContour] : equivalentContours) {
+    if (ourContour->inside() == theirContour->inside()) {
+      // Redundant, so just remove one of them from the results
+      removedContours.push_back(theirContour.get());
+    } else {
+      // One is a hole, one is a fill, so they cancel each other out. Remove both from the results
+      removedContours.push_back(theirContour.get());
+      removedContours.push_back(ourContour.get());
     }
   }
+  std::sort(removedContours.begin(), removedContours.end());
+  std::erase_if(results, [&](const auto &contour) {
+    return std::binary_search(removedContours.begin(), removedContours.end(), contour.get());
+  });
 }
 
-std::shared_ptr<FBBezierGraph> FBBezierGraph::intersectWithBezierGraph(std::shared_ptr<FBBezierGraph> graph) {
+std::shared_ptr<FBBezierGraph> FBBezierGraph::intersectWithBezierGraph(std::shared_ptr<FBBezierGraph> graph,
+                                                                       FBBooleanStats *stats) {
+  FBTraceSpan span("intersectWithBezierGraph");
+
   // First insert FBEdgeCrossings into both graphs where the graphs cross.
-  insertCrossingsWithBezierGraph(graph);
-  insertSelfCrossings();
-  graph->insertSelfCrossings();
-  cleanupCrossingsWithBezierGraph(graph);
+  insertAndCleanupCrossingsWithBezierGraph(graph, stats);
 
   // Handle the parts of the graphs that intersect first. Mark the parts
   //  of the graphs that are inside the other for the final result.
-  markCrossingsAsEntryOrExitWithBezierGraph(graph, true);
-  graph->markCrossingsAsEntryOrExitWithBezierGraph(shared_from_this(), true);
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::markCrossings, "markCrossings");
+    markCrossingsAsEntryOrExitWithBezierGraph(graph, true);
+    graph->markCrossingsAsEntryOrExitWithBezierGraph(shared_from_this(), true);
+  }
 
   // Walk the crossings and actually compute the final result for the intersecting parts
-  auto result = bezierGraphFromIntersections();
+  std::shared_ptr<FBBezierGraph> result;
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::intersections, "intersections");
+    result = bezierGraphFromIntersections();
+  }
 
   // Finally, process the contours that don't cross anything else. They're either
   //  completely contained in another contour, or disjoint.
-  intersectNonintersectingPartsIntoGraph(result, graph);
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::nonintersectingContours, "nonintersectingContours");
+    intersectNonintersectingPartsIntoGraph(result, graph);
+  }
 
   // Clean up crossings so the graphs can be reused, e.g. XOR will reuse graphs.
   removeCrossings();
@@ -227,54 +359,65 @@ void FBBezierGraph::intersectEquivalentNonintersectingContours(
     std::vector<std::shared_ptr<FBBezierContour>> &ourNonintersectingContours,
     std::vector<std::shared_ptr<FBBezierContour>> &theirNonintersectingContours,
     std::vector<std::shared_ptr<FBBezierContour>> &results) {
-  for (std::size_t ourIndex = 0; ourIndex < ourNonintersectingContours.size(); ++ourIndex) {
-    auto ourContour = ourNonintersectingContours[ourIndex];
-    for (std::size_t theirIndex = 0; theirIndex < theirNonintersectingContours.size(); ++theirIndex) {
-      auto theirContour = theirNonintersectingContours[theirIndex];
-
-      if (!ourContour->isEquivalent(theirContour)) {
-        continue;
-      }
-
-      if (ourContour->inside() == theirContour->inside()) {
-        // Redundant, so just add one of them to our results
-        results.push_back(ourContour);
+  auto equivalentContours = FBPairEquivalentContours(ourNonintersectingContours, theirNonintersectingContours);
+  for (const auto &[ourContour, theirContour] : equivalentContours) {
+    if (ourContour->inside() == theirContour->inside()) {
+      // Redundant, so just add one of them to our results
+      results.push_back(ourContour);
+    } else {
+      // One is a hole, one is a fill, so the hole cancels the fill. Add the hole to the results
+      if (theirContour->inside() == FBContourInsideHole) {
+        // theirContour is the hole, so add it
+        results.push_back(theirContour);
       } else {
-        // One is a hole, one is a fill, so the hole cancels the fill. Add the hole to the results
-        if (theirContour->inside() == FBContourInsideHole) {
-          // theirContour is the hole, so add it
-          results.push_back(theirContour);
-        } else {
-          // ourContour is the hole, so add it
-          results.push_back(ourContour);
-        }
+        // ourContour is the hole, so add it
+        results.push_back(ourContour);
       }
-
-      // Remove both from the inputs so they aren't processed later
-      theirNonintersectingContours.erase(theirNonintersectingContours.begin() + theirIndex);
-      ourNonintersectingContours.erase(ourNonintersectingContours.begin() + ourIndex);
-      ourIndex--;
-      break;
     }
   }
 }
 
-std::shared_ptr<FBBezierGraph> FBBezierGraph::differenceWithBezierGraph(std::shared_ptr<FBBezierGraph> graph) {
+std::shared_ptr<FBBezierGraph> FBBezierGraph::differenceWithBezierGraph(std::shared_ptr<FBBezierGraph> graph,
+                                                                        FBBooleanStats *stats) {
+  FBTraceSpan span("differenceWithBezierGraph");
+
   // First insert FBEdgeCrossings into both graphs where the graphs cross.
-  insertCrossingsWithBezierGraph(graph);
-  insertSelfCrossings();
-  graph->insertSelfCrossings();
-  cleanupCrossingsWithBezierGraph(graph);
+  insertAndCleanupCrossingsWithBezierGraph(graph, stats);
 
   // Handle the parts of the graphs that intersect first. We're subtracting
   //  graph from outselves. Mark the outside parts of ourselves, and the inside
   //  parts of them for the final result.
-  markCrossingsAsEntryOrExitWithBezierGraph(graph, false);
-  graph->markCrossingsAsEntryOrExitWithBezierGraph(shared_from_this(), true);
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::markCrossings, "markCrossings");
+    markCrossingsAsEntryOrExitWithBezierGraph(graph, false);
+    graph->markCrossingsAsEntryOrExitWithBezierGraph(shared_from_this(), true);
+  }
 
   // Walk the crossings and actually compute the final result for the intersecting parts
-  auto result = bezierGraphFromIntersections();
+  std::shared_ptr<FBBezierGraph> result;
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::intersections, "intersections");
+    result = bezierGraphFromIntersections();
+  }
+
+  // Finally, process the contours that don't cross anything else. They're either
+  //  completely contained in another contour, or disjoint.
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::nonintersectingContours, "nonintersectingContours");
+    differenceNonintersectingPartsIntoGraph(result, graph);
+  }
+
+  // Clean up crossings so the graphs can be reused
+  removeCrossings();
+  graph->removeCrossings();
+  removeOverlaps();
+  graph->removeOverlaps();
 
+  return result;
+}
+
+void FBBezierGraph::differenceNonintersectingPartsIntoGraph(std::shared_ptr<FBBezierGraph> result,
+                                                            std::shared_ptr<FBBezierGraph> graph) {
   // Finally, process the contours that don't cross anything else. They're either
   //  completely contained in another contour, or disjoint.
   auto ourNonintersectingContours = nonintersectingContours();
@@ -305,47 +448,25 @@ std::shared_ptr<FBBezierGraph> FBBezierGraph::differenceWithBezierGraph(std::sha
   for (const auto &contour : finalNonintersectingContours) {
     result->addContour(contour);
   }
-
-  // Clean up crossings so the graphs can be reused
-  removeCrossings();
-  graph->removeCrossings();
-  removeOverlaps();
-  graph->removeOverlaps();
-
-  return result;
 }
 
 void FBBezierGraph::differenceEquivalentNonintersectingContours(
     std::vector<std::shared_ptr<FBBezierContour>> &ourNonintersectingContours,
     std::vector<std::shared_ptr<FBBezierContour>> &theirNonintersectingContours,
     std::vector<std::shared_ptr<FBBezierContour>> &results) {
-  for (std::size_t ourIndex = 0; ourIndex < ourNonintersectingContours.size(); ++ourIndex) {
-    auto ourContour = ourNonintersectingContours[ourIndex];
-    for (std::size_t theirIndex = 0; theirIndex < theirNonintersectingContours.size(); ++theirIndex) {
-      auto theirContour = theirNonintersectingContours[theirIndex];
-
-      if (!ourContour->isEquivalent(theirContour)) {
-        continue;
-      }
-
-      if (ourContour->inside() != theirContour->inside()) {
-        // Trying to subtract a hole from a fill or vice versa does nothing, so add the original to
-        // the results
-        results.push_back(ourContour);
-      } else if (ourContour->inside() == FBContourInsideHole && theirContour->inside() == FBContourInsideHole) {
-        // Subtracting a hole from a hole is redundant, so just add one of them to the results
-        results.push_back(ourContour);
-      } else {
-        // Both are fills, and subtracting a fill from a fill removes both. So add neither to the
-        // results
-        //  Intentionally do nothing for this case.
-      }
-
-      // Remove both from the inputs so they aren't processed later
-      theirNonintersectingContours.erase(theirNonintersectingContours.begin() + theirIndex);
-      ourNonintersectingContours.erase(ourNonintersectingContours.begin() + ourIndex);
-      ourIndex--;
-      break;
+  auto equivalentContours = FBPairEquivalentContours(ourNonintersectingContours, theirNonintersectingContours);
+  for (const auto &[ourContour, theirContour] : equivalentContours) {
+    if (ourContour->inside() != theirContour->inside()) {
+      // Trying to subtract a hole from a fill or vice versa does nothing, so add the original to
+      // the results
+      results.push_back(ourContour);
+    } else if (ourContour->inside() == FBContourInsideHole && theirContour->inside() == FBContourInsideHole) {
+      // Subtracting a hole from a hole is redundant, so just add one of them to the results
+      results.push_back(ourContour);
+    } else {
+      // Both are fills, and subtracting a fill from a fill removes both. So add neither to the
+      // results
+      //  Intentionally do nothing for this case.
     }
   }
 }
@@ -354,140 +475,438 @@ void FBBezierGraph::markCrossingsAsEntryOrExitWithBezierGraph(std::shared_ptr<FB
                                                               bool markInside) {
   // Walk each contour in ourself and mark the crossings with each intersecting contour as entering
   //  or exiting the final contour.
-  for (auto contour : contours()) {
-    auto intersectingContours = contour->intersectingContours();
-    for (auto otherContour : intersectingContours) {
+  const auto &adjacency = *_contourAdjacency;
+  for (const auto &contour : _contours) {
+    for (auto otherIndex : adjacency.intersectingContours(contour->adjacencyIndex())) {
+      const auto &otherContour = adjacency.contour(otherIndex);
       // If the other contour is a hole, that's a special case where we flip marking inside/outside.
       //  For example, if we're doing a union, we'd normally mark the outside of contours. But
       //  if we're unioning with a hole, we want to cut into that hole so we mark the inside instead
       //  of outside.
       if (otherContour->inside() == FBContourInsideHole) {
-        contour->markCrossingsAsEntryOrExitWithContour(otherContour, !markInside);
+        contour->markCrossingsAsEntryOrExitWithContour(otherContour, !markInside, adjacency);
       } else {
-        contour->markCrossingsAsEntryOrExitWithContour(otherContour, markInside);
+        contour->markCrossingsAsEntryOrExitWithContour(otherContour, markInside, adjacency);
       }
     }
   }
 }
 
-std::shared_ptr<FBBezierGraph> FBBezierGraph::xorWithBezierGraph(std::shared_ptr<FBBezierGraph> graph) {
-  // XOR is done by combing union (OR), intersect (AND) and difference. Specifically
-  //  we compute the union of the two graphs, the intersect of them, then subtract
-  //  the intersect from the union.
-  // Note that we reuse the resulting graphs, which is why it is important that operations
-  //  clean up any crossings when their done, otherwise they could interfere with subsequent
-  //  operations.
+std::shared_ptr<FBBezierGraph> FBBezierGraph::xorWithBezierGraph(std::shared_ptr<FBBezierGraph> graph,
+                                                                 FBBooleanStats *stats) {
+  FBTraceSpan span("xorWithBezierGraph");
+
+  // XOR is done by combining union (OR) and intersect (AND). The crossings are found once, and
+  //  walked once for the union of the two graphs and once for the intersect of them. The
+  //  intersect is always inside the union, so putting its contours in as holes subtracts it.
 
   // First insert FBEdgeCrossings into both graphs where the graphs
   //  cross.
-  insertCrossingsWithBezierGraph(graph);
-  insertSelfCrossings();
-  graph->insertSelfCrossings();
-  cleanupCrossingsWithBezierGraph(graph);
+  insertAndCleanupCrossingsWithBezierGraph(graph, stats);
 
   // Handle the parts of the graphs that intersect first. Mark the parts
   //  of the graphs that are outside the other for the final result.
-  markCrossingsAsEntryOrExitWithBezierGraph(graph, false);
-  graph->markCrossingsAsEntryOrExitWithBezierGraph(shared_from_this(), false);
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::markCrossings, "markCrossings");
+    markCrossingsAsEntryOrExitWithBezierGraph(graph, false);
+    graph->markCrossingsAsEntryOrExitWithBezierGraph(shared_from_this(), false);
+  }
 
   // Walk the crossings and actually compute the final result for the intersecting parts
-  auto allParts = bezierGraphFromIntersections();
-  unionNonintersectingPartsIntoGraph(allParts, graph);
+  std::shared_ptr<FBBezierGraph> allParts;
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::intersections, "intersections");
+    allParts = bezierGraphFromIntersections();
+  }
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::nonintersectingContours, "nonintersectingContours");
+    unionNonintersectingPartsIntoGraph(allParts, graph);
+  }
 
   markAllCrossingsAsUnprocessed();
   graph->markAllCrossingsAsUnprocessed();
 
   // Handle the parts of the graphs that intersect first. Mark the parts
   //  of the graphs that are inside the other for the final result.
-  markCrossingsAsEntryOrExitWithBezierGraph(graph, true);
-  graph->markCrossingsAsEntryOrExitWithBezierGraph(shared_from_this(), true);
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::markCrossings, "markCrossings");
+    markCrossingsAsEntryOrExitWithBezierGraph(graph, true);
+    graph->markCrossingsAsEntryOrExitWithBezierGraph(shared_from_this(), true);
+  }
 
-  auto intersectingParts = bezierGraphFromIntersections();
-  intersectNonintersectingPartsIntoGraph(intersectingParts, graph);
+  std::shared_ptr<FBBezierGraph> intersectingParts;
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::intersections, "intersections");
+    intersectingParts = bezierGraphFromIntersections();
+  }
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::nonintersectingContours, "nonintersectingContours");
+    intersectNonintersectingPartsIntoGraph(intersectingParts, graph);
+  }
 
-  // Clean up crossings so the graphs can be reused, e.g. XOR will reuse graphs.
+  // Clean up crossings so the graphs can be reused
   removeCrossings();
   graph->removeCrossings();
   removeOverlaps();
   graph->removeOverlaps();
 
-  return allParts->differenceWithBezierGraph(intersectingParts);
+  return FBExclusiveOrOfParts(allParts, intersectingParts);
+}
+
+FBBooleanGraphResults FBBezierGraph::allBooleanResultsWithBezierGraph(std::shared_ptr<FBBezierGraph> graph,
+                                                                      FBBooleanStats *stats) {
+  FBTraceSpan span("allBooleanResultsWithBezierGraph");
+
+  // The crossings are the same for all the operations, so only insert them once. Each operation
+  //  then marks them for itself, walks them, and marks them as unprocessed again for the next one.
+  insertAndCleanupCrossingsWithBezierGraph(graph, stats);
+
+  FBBooleanGraphResults results;
+
+  // Union: the parts of both graphs that are outside the other
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::markCrossings, "markCrossings");
+    markCrossingsAsEntryOrExitWithBezierGraph(graph, false);
+    graph->markCrossingsAsEntryOrExitWithBezierGraph(shared_from_this(), false);
+  }
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::intersections, "intersections");
+    results.unionGraph = bezierGraphFromIntersections();
+  }
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::nonintersectingContours, "nonintersectingContours");
+    unionNonintersectingPartsIntoGraph(results.unionGraph, graph);
+  }
+  markAllCrossingsAsUnprocessed();
+  graph->markAllCrossingsAsUnprocessed();
+
+  // Intersect: the parts of both graphs that are inside the other
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::markCrossings, "markCrossings");
+    markCrossingsAsEntryOrExitWithBezierGraph(graph, true);
+    graph->markCrossingsAsEntryOrExitWithBezierGraph(shared_from_this(), true);
+  }
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::intersections, "intersections");
+    results.intersectGraph = bezierGraphFromIntersections();
+  }
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::nonintersectingContours, "nonintersectingContours");
+    intersectNonintersectingPartsIntoGraph(results.intersectGraph, graph);
+  }
+  markAllCrossingsAsUnprocessed();
+  graph->markAllCrossingsAsUnprocessed();
+
+  // Difference: the parts of ourselves outside of graph, and the parts of graph inside of us
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::markCrossings, "markCrossings");
+    markCrossingsAsEntryOrExitWithBezierGraph(graph, false);
+    graph->markCrossingsAsEntryOrExitWithBezierGraph(shared_from_this(), true);
+  }
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::intersections, "intersections");
+    results.differenceGraph = bezierGraphFromIntersections();
+  }
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::nonintersectingContours, "nonintersectingContours");
+    differenceNonintersectingPartsIntoGraph(results.differenceGraph, graph);
+  }
+
+  // Exclusive or comes straight from the union and intersect
+  results.xorGraph = FBExclusiveOrOfParts(results.unionGraph, results.intersectGraph);
+
+  // Clean up crossings so the graphs can be reused
+  removeCrossings();
+  graph->removeCrossings();
+  removeOverlaps();
+  graph->removeOverlaps();
+
+  return results;
+}
+
+// The intersections found between one candidate pair of edges, in the order the bezier clipping
+//  code reported them.
+struct FBEdgePairIntersections {
+  std::vector<std::shared_ptr<FBBezierIntersection>> intersections;
+  std::shared_ptr<FBBezierIntersectRange> intersectRange = nullptr;
+};
+
+// Finding the intersections between two edges only reads them (once their cached bounds have been
+//  computed), so when more than one thread is allowed, the intersections for all the candidate
+//  pairs are found up front with FBParallelFor, each into its own buffer. Everything that modifies
+//  the graphs (marking shared end points, deciding what crosses, adding crossings and overlaps) is
+//  still done afterwards on the calling thread, in candidate order, so the results don't depend on
+//  the number of threads.
+static void FBFindEdgePairIntersections(std::shared_ptr<FBBezierCurve> edge1, std::shared_ptr<FBBezierCurve> edge2,
+                                        bool findOverlap, FBEdgePairIntersections &result) {
+  edge1->intersectionsWithBezierCurve(edge2, findOverlap ? &result.intersectRange : nullptr,
+                                      [&](const std::shared_ptr<FBBezierIntersection> &intersection, bool *stop) {
+                                        result.intersections.push_back(intersection);
+                                      });
+}
+
+// Bounding volume hierarchies over the contours and the edges of a graph, numbered the way
+//  FBEdgeTable numbers them.
+struct FBGraphSpatialIndex {
+  FBBoundsTree contours;
+  FBBoundsTree edges;
+};
+
+static std::shared_ptr<const FBGraphSpatialIndex> FBMakeSpatialIndex(const FBEdgeTable &edges) {
+  std::vector<FBRect> contourRects;
+  std::vector<FBRect> edgeRects;
+  contourRects.reserve(edges.contourCount());
+  edgeRects.reserve(edges.edgeCount());
+  for (FBEdgeTable::Index contour = 0; contour < edges.contourCount(); contour++) {
+    contourRects.push_back(edges.contourBoundingRect(contour));
+  }
+  for (FBEdgeTable::Index edge = 0; edge < edges.edgeCount(); edge++) {
+    edgeRects.push_back(edges.boundingRect(edge));
+  }
+  return FBMakeShared<FBGraphSpatialIndex>(FBBoundsTree(std::move(contourRects)), FBBoundsTree(std::move(edgeRects)));
+}
+
+// Appends the (query edge, indexed edge) pairs whose bounding rects might overlap to pairs
+static void FBFindOverlappingEdges(const FBEdgeTable &queryEdges, const FBGraphSpatialIndex &index,
+                                   std::vector<std::pair<FBEdgeTable::Index, FBEdgeTable::Index>> &pairs) {
+  std::vector<size_t> overlappingIndices;
+  for (FBEdgeTable::Index contour = 0; contour < queryEdges.contourCount(); contour++) {
+    // Contour level culling: skip the contour entirely if it's nowhere near any indexed contour
+    if (!index.contours.mightOverlap(queryEdges.contourBoundingRect(contour))) {
+      continue;
+    }
+
+    for (auto edge = queryEdges.firstEdgeOfContour(contour); edge < queryEdges.endEdgeOfContour(contour); edge++) {
+      overlappingIndices.clear();
+      index.edges.overlappingIndices(queryEdges.boundingRect(edge), overlappingIndices);
+      for (auto indexedEdge : overlappingIndices) {
+        pairs.push_back({edge, static_cast<FBEdgeTable::Index>(indexedEdge)});
+      }
+    }
+  }
+}
+
+// A contour of ours and a contour of theirs made of exactly the same edges, lined up the way
+//  FBBezierContour::isIdentical() reports
+struct FBIdenticalContours {
+  FBEdgeTable::Index ourContour;
+  FBEdgeTable::Index theirContour;
+  size_t offset;
+  bool reversed;
+};
+
+// Contours with point edges are left to the intersection code, which decides how those line up
+static bool FBCanPairIdenticalContour(const FBBezierContour &contour) {
+  return contour.edges().size() > 1
+         && std::ranges::none_of(contour.edges(), [](const auto &edge) { return edge->isPoint(); });
+}
+
+// Finds the identical contours of the two graphs by their fingerprints, ordered by our contour
+//  then their contour
+static std::vector<FBIdenticalContours> FBFindIdenticalContours(const FBEdgeTable &ourEdges,
+                                                                const FBEdgeTable &theirEdges) {
+  std::vector<std::pair<uint64_t, FBEdgeTable::Index>> theirFingerprints;
+  theirFingerprints.reserve(theirEdges.contourCount());
+  for (FBEdgeTable::Index contour = 0; contour < theirEdges.contourCount(); contour++) {
+    if (FBCanPairIdenticalContour(*theirEdges.contour(contour))) {
+      theirFingerprints.push_back({theirEdges.contour(contour)->fingerprint(), contour});
+    }
+  }
+  std::sort(theirFingerprints.begin(), theirFingerprints.end());
+
+  std::vector<FBIdenticalContours> identicalContours;
+  for (FBEdgeTable::Index contour = 0; contour < ourEdges.contourCount(); contour++) {
+    const auto &ourContour = ourEdges.contour(contour);
+    if (theirFingerprints.empty() || !FBCanPairIdenticalContour(*ourContour)) {
+      continue;
+    }
+    auto fingerprint = ourContour->fingerprint();
+    auto match = std::lower_bound(theirFingerprints.begin(), theirFingerprints.end(),
+                                  std::make_pair(fingerprint, FBEdgeTable::Index(0)));
+    for (; match != theirFingerprints.end() && match->first == fingerprint; ++match) {
+      size_t offset = 0;
+      bool reversed = false;
+      if (ourContour->isIdentical(*theirEdges.contour(match->second), &offset, &reversed)) {
+        identicalContours.push_back({contour, match->second, offset, reversed});
+      }
+    }
+  }
+  return identicalContours;
+}
+
+// Gives two identical contours the overlap intersecting their edges would have found: every edge
+//  overlaps its twin from end to end, and every end point is shared.
+static void FBAddIdenticalContourOverlap(const std::shared_ptr<FBBezierContour> &ourContour,
+                                         const std::shared_ptr<FBBezierContour> &theirContour, size_t offset,
+                                         bool reversed) {
+  auto overlap = FBMakeShared<FBContourOverlap>();
+  auto ourEdges = ourContour->edges();
+  auto theirEdges = theirContour->edges();
+  size_t count = ourEdges.size();
+  for (size_t index = 0; index < count; index++) {
+    const auto &ourEdge = ourEdges[index];
+    const auto &theirEdge = theirEdges[reversed ? (offset + count - index) % count : (offset + index) % count];
+    ourEdge->setStartShared(true);
+    theirEdge->setStartShared(true);
+    auto range = FBMakeShared<FBBezierIntersectRange>(ourEdge, FBRangeMake(0.0, 1.0), theirEdge,
+                                                      FBRangeMake(0.0, 1.0), reversed);
+    overlap->addOverlap(range, ourEdge, theirEdge);
+  }
+  ourContour->addOverlap(overlap);
+  theirContour->addOverlap(overlap);
 }
 
 void FBBezierGraph::insertCrossingsWithBezierGraph(std::shared_ptr<FBBezierGraph> other) {
   // Find all intersections and, if they cross the other graph, create crossings for them, and
   // insert
   //  them into each graph's edges.
-  for (const auto &ourContour : contours()) {
-    for (const auto &theirContour : other->contours()) {
-      auto overlap = std::make_shared<FBContourOverlap>();
-
-      for (auto ourEdge : ourContour->edges()) {
-        for (auto theirEdge : theirContour->edges()) {
-          // Find all intersections between these two edges (curves)
-          std::shared_ptr<FBBezierIntersectRange> intersectRange = nullptr;
-          ourEdge->intersectionsWithBezierCurve(theirEdge, &intersectRange,
-                                                [&](std::shared_ptr<FBBezierIntersection> intersection, bool *stop) {
-                                                  // If this intersection happens at one of the ends of the edges,
-                                                  // then mark
-                                                  //  that on the edge. We do this here because not all
-                                                  //  intersections create
-                                                  //  crossings, but we still need to know when the intersections
-                                                  //  fall on end points
-                                                  //  later on in the algorithm.
-                                                  if (intersection->isAtStartOfCurve1()) {
-                                                    ourEdge->setStartShared(true);
-                                                  }
-                                                  if (intersection->isAtStopOfCurve1()) {
-                                                    ourEdge->next()->setStartShared(true);
-                                                  }
-                                                  if (intersection->isAtStartOfCurve2()) {
-                                                    theirEdge->setStartShared(true);
-                                                  }
-                                                  if (intersection->isAtStopOfCurve2()) {
-                                                    theirEdge->next()->setStartShared(true);
-                                                  }
-
-                                                  // Don't add a crossing unless one edge actually crosses the
-                                                  // other
-                                                  if (!ourEdge->crossesEdge(theirEdge, intersection)) {
-                                                    return;
-                                                  }
-
-                                                  // Add crossings to both graphs for this intersection, and point
-                                                  // them at each other
-                                                  auto ourCrossing = std::make_shared<FBEdgeCrossing>(intersection);
-                                                  auto theirCrossing = std::make_shared<FBEdgeCrossing>(intersection);
-                                                  ourCrossing->setCounterpart(theirCrossing);
-                                                  theirCrossing->setCounterpart(ourCrossing);
-                                                  ourEdge->addCrossing(ourCrossing);
-                                                  theirEdge->addCrossing(theirCrossing);
-                                                });
-          if (intersectRange != nullptr) {
-            overlap->addOverlap(intersectRange, ourEdge, theirEdge);
-          }
-        } // end theirEdges
-      } // end ourEdges
+  //
+  // Edges can only intersect if their bounding rects overlap, so instead of testing every pair of
+  //  edges of every pair of contours, we query bounding volume hierarchies over one graph's
+  //  contours and edges with the other graph's edges, and only hand the candidate pairs to the
+  //  bezier clipping code. The candidates are visited in the same order the exhaustive loops would
+  //  visit them, so the crossings and overlaps come out exactly the same.
+  FBEdgeTable ourEdges(contours());
+  FBEdgeTable theirEdges(other->contours());
+
+  // Use whichever graph was prepared with an index. The overlap test is symmetric, so querying
+  //  our index with their edges finds the same pairs.
+  std::vector<std::pair<FBEdgeTable::Index, FBEdgeTable::Index>> candidates;
+  if (_spatialIndex != nullptr && other->_spatialIndex == nullptr) {
+    FBFindOverlappingEdges(theirEdges, *_spatialIndex, candidates);
+    for (auto &candidate : candidates) {
+      std::swap(candidate.first, candidate.second);
+    }
+  } else {
+    auto theirIndex = other->_spatialIndex != nullptr ? other->_spatialIndex : FBMakeSpatialIndex(theirEdges);
+    FBFindOverlappingEdges(ourEdges, *theirIndex, candidates);
+  }
 
-      // At this point we've found all intersections/overlaps between ourContour and theirContour
+  // Contours that are exact copies of each other, like the same shape on two layers, overlap
+  //  completely and can't cross anything the other doesn't. Pair them up by fingerprint and
+  //  record the overlap directly instead of intersecting their edges.
+  auto identicalContours = FBFindIdenticalContours(ourEdges, theirEdges);
+  if (!identicalContours.empty()) {
+    auto isBefore = [](const FBIdenticalContours &identical, const auto &contours) {
+      return std::make_pair(identical.ourContour, identical.theirContour) < contours;
+    };
+    std::erase_if(candidates, [&](const auto &candidate) {
+      auto contours = std::make_pair(ourEdges.contourOfEdge(candidate.first),
+                                     theirEdges.contourOfEdge(candidate.second));
+      auto identical = std::lower_bound(identicalContours.begin(), identicalContours.end(), contours, isBefore);
+      return identical != identicalContours.end() && identical->ourContour == contours.first
+             && identical->theirContour == contours.second;
+    });
+    for (const auto &identical : identicalContours) {
+      FBAddIdenticalContourOverlap(ourEdges.contour(identical.ourContour), theirEdges.contour(identical.theirContour),
+                                   identical.offset, identical.reversed);
+    }
+  }
 
-      // Determine if the overlaps constitute crossings
-      if (!overlap->isComplete()) {
-        // The contours aren't equivalent so see if they're crossings
-        overlap->runsWithBlock([](const std::shared_ptr<FBEdgeOverlapRun> run, bool *stop) {
-          if (!run->isCrossing()) {
-            return;
-          }
+  // Candidates are (our edge, their edge) pairs, ordered by our contour, their contour, our edge,
+  //  their edge.
+  std::sort(candidates.begin(), candidates.end(), [&](const auto &candidate1, const auto &candidate2) {
+    auto contours1 = std::make_pair(ourEdges.contourOfEdge(candidate1.first), theirEdges.contourOfEdge(candidate1.second));
+    auto contours2 = std::make_pair(ourEdges.contourOfEdge(candidate2.first), theirEdges.contourOfEdge(candidate2.second));
+    return std::tie(contours1, candidate1) < std::tie(contours2, candidate2);
+  });
+
+  bool parallel = FBThreadCount() > 1;
+  std::vector<FBEdgePairIntersections> results;
+  if (parallel) {
+    ourEdges.prepareForConcurrentIntersections();
+    theirEdges.prepareForConcurrentIntersections();
+    results.resize(candidates.size());
+    FBParallelFor(candidates.size(), [&](size_t index) {
+      FBFindEdgePairIntersections(ourEdges.curve(candidates[index].first), theirEdges.curve(candidates[index].second),
+                                  true, results[index]);
+    });
+  }
+
+  for (size_t first = 0; first < candidates.size();) {
+    auto ourContourIndex = ourEdges.contourOfEdge(candidates[first].first);
+    auto theirContourIndex = theirEdges.contourOfEdge(candidates[first].second);
+    const auto &ourContour = ourEdges.contour(ourContourIndex);
+    const auto &theirContour = theirEdges.contour(theirContourIndex);
+    std::shared_ptr<FBContourOverlap> overlap = nullptr;
+
+    size_t last = first;
+    for (; last < candidates.size() && ourEdges.contourOfEdge(candidates[last].first) == ourContourIndex
+           && theirEdges.contourOfEdge(candidates[last].second) == theirContourIndex;
+         last++) {
+      const auto &ourEdge = ourEdges.curve(candidates[last].first);
+      const auto &theirEdge = theirEdges.curve(candidates[last].second);
+
+      // Find all intersections between these two edges (curves)
+      FBEdgePairIntersections found;
+      if (!parallel) {
+        FBFindEdgePairIntersections(ourEdge, theirEdge, true, found);
+      }
+      const auto &result = parallel ? results[last] : found;
+
+      for (const auto &intersection : result.intersections) {
+        // If this intersection happens at one of the ends of the edges, then mark
+        //  that on the edge. We do this here because not all intersections create
+        //  crossings, but we still need to know when the intersections fall on end points
+        //  later on in the algorithm.
+        if (intersection->isAtStartOfCurve1()) {
+          ourEdge->setStartShared(true);
+        }
+        if (intersection->isAtStopOfCurve1()) {
+          ourEdge->next()->setStartShared(true);
+        }
+        if (intersection->isAtStartOfCurve2()) {
+          theirEdge->setStartShared(true);
+        }
+        if (intersection->isAtStopOfCurve2()) {
+          theirEdge->next()->setStartShared(true);
+        }
+
+        // Don't add a crossing unless one edge actually crosses the other
+        if (!ourEdge->crossesEdge(theirEdge, intersection)) {
+          continue;
+        }
 
-          // The two ends of the overlap run should serve as crossings
-          run->addCrossings();
-        });
+        // Add crossings to both graphs for this intersection, and point them at each other
+        auto ourCrossing = FBMakeShared<FBEdgeCrossing>(intersection);
+        auto theirCrossing = FBMakeShared<FBEdgeCrossing>(intersection);
+        ourCrossing->setCounterpart(theirCrossing);
+        theirCrossing->setCounterpart(ourCrossing);
+        ourEdge->addCrossing(ourCrossing);
+        theirEdge->addCrossing(theirCrossing);
       }
+      if (result.intersectRange != nullptr) {
+        // Only contour pairs that actually overlap somewhere need an overlap object
+        if (overlap == nullptr) {
+          overlap = FBMakeShared<FBContourOverlap>();
+        }
+        overlap->addOverlap(result.intersectRange, ourEdge, theirEdge);
+      }
+    } // end candidate edge pairs
+    first = last;
+
+    if (overlap == nullptr) {
+      continue;
+    }
+
+    // At this point we've found all intersections/overlaps between ourContour and theirContour
+
+    // Determine if the overlaps constitute crossings
+    if (!overlap->isComplete()) {
+      // The contours aren't equivalent so see if they're crossings
+      overlap->runsWithBlock([](const std::shared_ptr<FBEdgeOverlapRun> run, bool *stop) {
+        if (!run->isCrossing()) {
+          return;
+        }
 
-      ourContour->addOverlap(overlap);
-      theirContour->addOverlap(overlap);
-    } // end theirContours
-  } // end ourContours
+        // The two ends of the overlap run should serve as crossings
+        run->addCrossings();
+      });
+    }
+
+    ourContour->addOverlap(overlap);
+    theirContour->addOverlap(overlap);
+  } // end contour pairs
 }
 
 void FBBezierGraph::cleanupCrossingsWithBezierGraph(std::shared_ptr<FBBezierGraph> other) {
@@ -501,8 +920,8 @@ void FBBezierGraph::cleanupCrossingsWithBezierGraph(std::shared_ptr<FBBezierGrap
 
 void FBBezierGraph::removeCrossingsInOverlaps() {
   for (auto ourContour : contours()) {
-    for (auto ourEdge : ourContour->edges()) {
-      ourEdge->crossingsCopyWithBlock([&](std::shared_ptr<FBEdgeCrossing> crossing, bool *stop) {
+    for (const auto &ourEdge : ourContour->edges()) {
+      ourEdge->crossingsCopyWithBlock([&](const std::shared_ptr<FBEdgeCrossing> &crossing, bool *stop) {
         if (crossing->fromCrossingOverlap()) {
           return;
         }
@@ -520,96 +939,270 @@ void FBBezierGraph::removeCrossingsInOverlaps() {
 void FBBezierGraph::removeDuplicateCrossings() {
   // Find any duplicate crossings. These will happen at the endpoints of edges.
   for (auto ourContour : contours()) {
-    for (auto ourEdge : ourContour->edges()) {
-      ourEdge->crossingsCopyWithBlock([&](std::shared_ptr<FBEdgeCrossing> crossing, bool *stop) {
-        if (crossing->isAtStart() && crossing->edge()->previous()->lastCrossing()->isAtEnd()) {
-          // Found a duplicate. Remove this crossing and its counterpart
-          auto counterpart = crossing->counterpart();
-          crossing->removeFromEdge();
-          counterpart->removeFromEdge();
+    for (const auto &ourEdge : ourContour->edges()) {
+      ourEdge->crossingsCopyWithBlock([&](const std::shared_ptr<FBEdgeCrossing> &crossing, bool *stop) {
+        // The neighbouring edges may not have any crossings at all (messaging nil in the original
+        //  Objective-C code silently answered NO), so check before dereferencing.
+        if (crossing->isAtStart() && crossing->edge() != nullptr) {
+          auto previousCrossing = crossing->edge()->previous()->lastCrossing();
+          if (previousCrossing != nullptr && previousCrossing->isAtEnd()) {
+            // Found a duplicate. Remove this crossing and its counterpart
+            auto counterpart = crossing->counterpart();
+            crossing->removeFromEdge();
+            counterpart->removeFromEdge();
+          }
         }
-        if (crossing->isAtEnd() && crossing->edge() != nullptr && crossing->edge()->next()->firstCrossing()->isAtStart()) {
-          // Found a duplicate. Remove this crossing and its counterpart
-          auto counterpart = crossing->edge()->next()->firstCrossing()->counterpart();
-          crossing->edge()->next()->firstCrossing()->removeFromEdge();
-          counterpart->removeFromEdge();
+        if (crossing->isAtEnd() && crossing->edge() != nullptr) {
+          auto nextCrossing = crossing->edge()->next()->firstCrossing();
+          if (nextCrossing != nullptr && nextCrossing->isAtStart()) {
+            // Found a duplicate. Remove this crossing and its counterpart
+            auto counterpart = nextCrossing->counterpart();
+            nextCrossing->removeFromEdge();
+            counterpart->removeFromEdge();
+          }
         }
       });
     }
   }
 }
 
+// A self crossing candidate: an edge of one contour and an edge of an earlier contour of the same
+//  graph whose bounding rects might overlap.
+struct FBSelfCrossingCandidate {
+  FBEdgeTable::Index firstContour;
+  FBEdgeTable::Index secondContour;
+  FBEdgeTable::Index firstEdge;
+  FBEdgeTable::Index secondEdge;
+
+  // Ordered the way the pairwise contour loops used to visit them
+  bool operator<(const FBSelfCrossingCandidate &other) const {
+    if (firstContour != other.firstContour) {
+      return firstContour > other.firstContour; // contours are visited last to first
+    }
+    return std::tie(secondContour, firstEdge, secondEdge)
+           < std::tie(other.secondContour, other.firstEdge, other.secondEdge);
+  }
+};
+
+// Sort and sweep: sort all the edges by the left side of their bounding rects, then sweep left
+//  to right keeping the edges whose rects are still open. Only edges from different contours whose
+//  rects FBLineBoundsMightOverlap() are reported.
+static std::vector<FBSelfCrossingCandidate> FBSelfCrossingCandidates(const FBEdgeTable &edges) {
+  // Same tolerance FBLineBoundsMightOverlap uses; dropping an edge from the sweep must never be
+  //  stricter than that test.
+  static const FBFloat FBSweepClosenessThreshold = 1e-9;
+
+  std::vector<FBEdgeTable::Index> sortedEdges(edges.edgeCount());
+  for (FBEdgeTable::Index edge = 0; edge < edges.edgeCount(); edge++) {
+    sortedEdges[edge] = edge;
+  }
+  std::sort(sortedEdges.begin(), sortedEdges.end(), [&](FBEdgeTable::Index edge1, FBEdgeTable::Index edge2) {
+    return edges.boundingMinX(edge1) < edges.boundingMinX(edge2);
+  });
+
+  std::vector<FBSelfCrossingCandidate> candidates;
+  std::vector<FBEdgeTable::Index> active;
+  for (auto edge : sortedEdges) {
+    FBFloat left = edges.boundingMinX(edge);
+    FBRect rect = edges.boundingRect(edge);
+    auto contour = edges.contourOfEdge(edge);
+    for (size_t i = 0; i < active.size();) {
+      auto other = active[i];
+      if (left - edges.boundingMaxX(other) > FBSweepClosenessThreshold) {
+        // Closed before this edge starts, so it can't overlap any edge after it either
+        active[i] = active.back();
+        active.pop_back();
+        continue;
+      }
+      auto otherContour = edges.contourOfEdge(other);
+      if (otherContour != contour && FBLineBoundsMightOverlap(rect, edges.boundingRect(other))) {
+        if (contour > otherContour) {
+          candidates.push_back({contour, otherContour, edge, other});
+        } else {
+          candidates.push_back({otherContour, contour, other, edge});
+        }
+      }
+      i++;
+    }
+    active.push_back(edge);
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+  return candidates;
+}
+
+// A pair of contours, by index in an FBEdgeTable, that cross each other
+using FBCrossingContours = std::pair<FBEdgeTable::Index, FBEdgeTable::Index>;
+
+// Determine if each contour is a filled region or a hole. Determine this by casting a ray from
+//  a point on the contour to the outside of the entire graph, and counting how many of the other
+//  contours the point lies inside of, which is its nesting depth in the graph. If it's an odd
+//  number, the contour resides inside of a filled region, meaning it must be a hole. Otherwise it
+//  creates a filled region. Contours that cross the test contour don't count.
+//
+// The rays are horizontal, so rather than testing every ray against every contour, the rays are
+//  sorted by height and swept from the bottom up, keeping the contours whose bounding rects
+//  straddle the current height active. Only those can intersect the ray.
+//
+// NOTE: this requires the self crossings to be in place, since they decide the test points.
+static void FBClassifyContourInsides(const FBEdgeTable &edges, const std::vector<FBCrossingContours> &crossingContours,
+                                     FBRect graphBounds) {
+  FBTraceLeafSpan span("FBClassifyContourInsides",
+                       [&] { return std::format("{} contours, {} edges", edges.contourCount(), edges.edgeCount()); });
+  using Index = FBEdgeTable::Index;
+  struct FBContourRay {
+    FBPoint testPoint;
+    Index contour;
+  };
+  std::vector<FBContourRay> rays;
+  rays.reserve(edges.contourCount());
+  for (Index contour = 0; contour < edges.contourCount(); contour++) {
+    rays.push_back({edges.contour(contour)->testPointForContainment(), contour});
+  }
+  std::sort(rays.begin(), rays.end(), [](const FBContourRay &ray1, const FBContourRay &ray2) {
+    return std::tie(ray1.testPoint.y, ray1.contour) < std::tie(ray2.testPoint.y, ray2.contour);
+  });
+
+  std::vector<Index> contoursByMinimumY(edges.contourCount());
+  std::iota(contoursByMinimumY.begin(), contoursByMinimumY.end(), 0);
+  std::stable_sort(contoursByMinimumY.begin(), contoursByMinimumY.end(), [&](Index contour1, Index contour2) {
+    return FBMinY(edges.contourBoundingRect(contour1)) < FBMinY(edges.contourBoundingRect(contour2));
+  });
+
+  auto isBelow = [](FBFloat value, FBFloat maximum) {
+    return value < maximum && !FBAreValuesClose(value, maximum);
+  };
+  std::vector<Index> active;
+  std::vector<size_t> depths(edges.contourCount(), 0);
+  size_t nextContour = 0;
+  for (const auto &ray : rays) {
+    FBFloat height = ray.testPoint.y;
+    while (nextContour < contoursByMinimumY.size()
+           && !isBelow(height, FBMinY(edges.contourBoundingRect(contoursByMinimumY[nextContour])))) {
+      active.push_back(contoursByMinimumY[nextContour]);
+      nextContour++;
+    }
+    std::erase_if(active, [&](Index contour) { return isBelow(FBMaxY(edges.contourBoundingRect(contour)), height); });
+
+    // Create the line from the test point to outside the graph
+    auto lineEndPoint = FBMakePoint(ray.testPoint.x > FBMinX(graphBounds) ? FBMinX(graphBounds) - 10
+                                                                          : FBMaxX(graphBounds) + 10,
+                                    height); /* just move us outside the bounds of the graph */
+    auto testCurve = FBMakeShared<FBBezierCurve>(ray.testPoint, lineEndPoint);
+    FBFloat rayMinimumX = std::min(ray.testPoint.x, lineEndPoint.x);
+    FBFloat rayMaximumX = std::max(ray.testPoint.x, lineEndPoint.x);
+
+    for (Index contour : active) {
+      FBRect contourBounds = edges.contourBoundingRect(contour);
+      if (contour == ray.contour || isBelow(FBMaxX(contourBounds), rayMinimumX)
+          || isBelow(rayMaximumX, FBMinX(contourBounds))) {
+        continue;
+      }
+      if (std::binary_search(crossingContours.begin(), crossingContours.end(),
+                             FBCrossingContours{ray.contour, contour})) {
+        continue; // don't test self intersections
+      }
+      if ((edges.contour(contour)->numberOfIntersectionsWithRay(testCurve) & 1) == 1) {
+        depths[ray.contour]++;
+      }
+    }
+  }
+
+  for (Index contour = 0; contour < edges.contourCount(); contour++) {
+    edges.contour(contour)->setInside((depths[contour] & 1) == 1 ? FBContourInsideHole : FBContourInsideFilled);
+  }
+}
+
 void FBBezierGraph::insertSelfCrossings() {
   // Find all intersections and, if they cross other contours in this graph, create crossings for
   // them, and insert
   //  them into each contour's edges.
-  auto remainingContours = contours();
-  while (remainingContours.size() > 0) {
-    auto firstContour = remainingContours.back();
-    for (auto secondContour : remainingContours) {
-      // We don't handle self-intersections on the contour this way, so skip them here
-      if (firstContour == secondContour) {
-        continue;
+  //
+  // Rather than comparing every contour with every other contour, edge by edge, a sort and sweep
+  //  pass over all the edges finds the pairs from different contours whose bounding rects might
+  //  overlap. Those are then visited in the same order the pairwise loops used to visit them.
+  //  (We don't handle self-intersections on a contour this way, so pairs on the same contour are
+  //  never candidates.)
+  FBEdgeTable edges(_contours);
+  auto candidates = FBSelfCrossingCandidates(edges);
+
+  // The contour level bounds checks only read the contours, so apply them before searching for
+  //  intersections in parallel
+  auto contoursMightOverlap = [&](const FBSelfCrossingCandidate &candidate) {
+    const auto &firstContour = edges.contour(candidate.firstContour);
+    const auto &secondContour = edges.contour(candidate.secondContour);
+    return FBLineBoundsMightOverlap(firstContour->boundingRect(), secondContour->boundingRect())
+           && FBLineBoundsMightOverlap(firstContour->bounds(), secondContour->bounds());
+  };
+  std::erase_if(candidates, [&](const FBSelfCrossingCandidate &candidate) { return !contoursMightOverlap(candidate); });
+
+  bool parallel = FBThreadCount() > 1;
+  std::vector<FBEdgePairIntersections> results;
+  if (parallel) {
+    edges.prepareForConcurrentIntersections();
+    results.resize(candidates.size());
+    FBParallelFor(candidates.size(), [&](size_t index) {
+      FBFindEdgePairIntersections(edges.curve(candidates[index].firstEdge), edges.curve(candidates[index].secondEdge),
+                                  false, results[index]);
+    });
+  }
+
+  // Compare the candidate edges looking for crossings
+  std::vector<FBCrossingContours> crossingContours;
+  for (size_t index = 0; index < candidates.size(); index++) {
+    const auto &firstEdge = edges.curve(candidates[index].firstEdge);
+    const auto &secondEdge = edges.curve(candidates[index].secondEdge);
+
+    // Find all intersections between these two edges (curves)
+    FBEdgePairIntersections found;
+    if (!parallel) {
+      FBFindEdgePairIntersections(firstEdge, secondEdge, false, found);
+    }
+    const auto &result = parallel ? results[index] : found;
+
+    for (const auto &intersection : result.intersections) {
+      // If this intersection happens at one of the ends of the edges, then mark
+      //  that on the edge. We do this here because not all intersections create
+      //  crossings, but we still need to know when the intersections fall on end points
+      //  later on in the algorithm.
+      if (intersection->isAtStartOfCurve1()) {
+        firstEdge->setStartShared(true);
+      } else if (intersection->isAtStopOfCurve1()) {
+        firstEdge->next()->setStartShared(true);
+      }
+      if (intersection->isAtStartOfCurve2()) {
+        secondEdge->setStartShared(true);
+      } else if (intersection->isAtStopOfCurve2()) {
+        secondEdge->next()->setStartShared(true);
       }
 
-      if (!FBLineBoundsMightOverlap(firstContour->boundingRect(), secondContour->boundingRect())
-          || !FBLineBoundsMightOverlap(firstContour->bounds(), secondContour->bounds())) {
+      // Don't add a crossing unless one edge actually crosses the other
+      if (!firstEdge->crossesEdge(secondEdge, intersection)) {
         continue;
       }
 
-      // Compare all the edges between these two contours looking for crossings
-      for (auto firstEdge : firstContour->edges()) {
-        for (auto secondEdge : secondContour->edges()) {
-          // Find all intersections between these two edges (curves)
-          firstEdge->intersectionsWithBezierCurve(
-              secondEdge, nullptr, [&](std::shared_ptr<FBBezierIntersection> intersection, bool *stop) {
-                // If this intersection happens at one of the ends of the edges,
-                // then mark
-                //  that on the edge. We do this here because not all
-                //  intersections create
-                //  crossings, but we still need to know when the intersections
-                //  fall on end points
-                //  later on in the algorithm.
-                if (intersection->isAtStartOfCurve1()) {
-                  firstEdge->setStartShared(true);
-                } else if (intersection->isAtStopOfCurve1()) {
-                  firstEdge->next()->setStartShared(true);
-                }
-                if (intersection->isAtStartOfCurve2()) {
-                  secondEdge->setStartShared(true);
-                } else if (intersection->isAtStopOfCurve2()) {
-                  secondEdge->next()->setStartShared(true);
-                }
-
-                // Don't add a crossing unless one edge actually crosses the
-                // other
-                if (!firstEdge->crossesEdge(secondEdge, intersection)) {
-                  return;
-                }
-
-                // Add crossings to both graphs for this intersection, and point
-                // them at each other
-                auto firstCrossing = std::make_shared<FBEdgeCrossing>(intersection);
-                auto secondCrossing = std::make_shared<FBEdgeCrossing>(intersection);
-                firstCrossing->setSelfCrossing(true);
-                secondCrossing->setSelfCrossing(true);
-                firstCrossing->setCounterpart(secondCrossing);
-                secondCrossing->setCounterpart(firstCrossing);
-                firstEdge->addCrossing(firstCrossing);
-                secondEdge->addCrossing(secondCrossing);
-              });
-        }
-      }
+      // Add crossings to both graphs for this intersection, and point them at each other
+      auto firstCrossing = FBMakeShared<FBEdgeCrossing>(intersection);
+      auto secondCrossing = FBMakeShared<FBEdgeCrossing>(intersection);
+      firstCrossing->setSelfCrossing(true);
+      secondCrossing->setSelfCrossing(true);
+      firstCrossing->setCounterpart(secondCrossing);
+      secondCrossing->setCounterpart(firstCrossing);
+      firstEdge->addCrossing(firstCrossing);
+      secondEdge->addCrossing(secondCrossing);
+      crossingContours.push_back({candidates[index].firstContour, candidates[index].secondContour});
+      crossingContours.push_back({candidates[index].secondContour, candidates[index].firstContour});
     }
-
-    // We just compared this contour to all the others, so we don't need to do it again
-    remainingContours.pop_back(); // do this at the end of the loop when we're done with it
   }
 
-  // Go through and mark each contour if its a hole or filled region
-  for (auto contour : _contours) {
-    contour->setInside(contourInsides(contour));
+  // Go through and mark each contour if its a hole or filled region. A prepared graph has already
+  //  done that, and it doesn't depend on the other graph.
+  if (_insidesClassified) {
+    return;
   }
+  std::sort(crossingContours.begin(), crossingContours.end());
+  crossingContours.erase(std::unique(crossingContours.begin(), crossingContours.end()), crossingContours.end());
+  FBClassifyContourInsides(edges, crossingContours, bounds());
 }
 
 FBRect FBBezierGraph::bounds() const {
@@ -628,33 +1221,6 @@ FBRect FBBezierGraph::bounds() const {
   return _bounds;
 }
 
-FBContourInside FBBezierGraph::contourInsides(std::shared_ptr<FBBezierContour> testContour) {
-  // Determine if this contour, which should reside in this graph, is a filled region or
-  //  a hole. Determine this by casting a ray from one edges of the contour to the outside of
-  //  the entire graph. Count how many times the ray intersects a contour in the graph. If it's
-  //  an odd number, the test contour resides inside of filled region, meaning it must be a hole.
-  //  Otherwise it's "outside" of the graph and creates a filled region.
-  // Create the line from the first point in the contour to outside the graph
-
-  // falseTE: this method requires insertSelfCrossings: to be call before it, and the self crossings
-  //  to be in place to work
-
-  auto testPoint = testContour->testPointForContainment();
-  auto lineEndPoint = FBMakePoint(testPoint.x > FBMinX(bounds()) ? FBMinX(bounds()) - 10 : FBMaxX(bounds()) + 10,
-                                  testPoint.y); /* just move us outside the bounds of the graph */
-  auto testCurve = std::make_shared<FBBezierCurve>(testPoint, lineEndPoint);
-
-  std::size_t intersectCount = 0;
-  for (auto contour : contours()) {
-    if (contour == testContour || contour->crossesOwnContour(testContour)) {
-      continue; // don't test self intersections
-    }
-
-    intersectCount += contour->numberOfIntersectionsWithRay(testCurve);
-  }
-  return (intersectCount & 1) == 1 ? FBContourInsideHole : FBContourInsideFilled;
-}
-
 std::shared_ptr<FBCurveLocation> FBBezierGraph::closestLocationToPoint(const FBPoint &point) {
   std::shared_ptr<FBCurveLocation> closestLocation = nullptr;
 
@@ -674,6 +1240,26 @@ std::shared_ptr<FBCurveLocation> FBBezierGraph::closestLocationToPoint(const FBP
   return closestLocation;
 }
 
+// Tests whether container contains testContour using a point of testContour that doesn't lie on
+//  container's edges: the midpoint of the first edge far enough from them, relative to the size of
+//  the test contour. If every edge midpoint lies on the container, the two are the same shape and
+//  the container doesn't contain the test contour.
+static bool FBContourContainsContour(const std::shared_ptr<FBBezierContour> &container,
+                                     const std::shared_ptr<FBBezierContour> &testContour) {
+  static const FBFloat FBRelativeDistanceThreshold = 1e-6;
+
+  auto testBounds = testContour->bounds();
+  auto threshold = FBRelativeDistanceThreshold * std::max(FBWidth(testBounds), FBHeight(testBounds));
+  for (const auto &edge : testContour->edges()) {
+    auto point = std::get<0>(edge->pointAtParameter(0.5));
+    auto location = container->closestLocationToPoint(point);
+    if (location != nullptr && location->distance() > threshold) {
+      return container->containsPoint(point);
+    }
+  }
+  return false;
+}
+
 bool FBBezierGraph::containsContour(std::shared_ptr<FBBezierContour> testContour) {
   // Determine the container, if any, for the test contour. We do this by casting a ray from one end
   // of the graph to the other,
@@ -692,8 +1278,19 @@ bool FBBezierGraph::containsContour(std::shared_ptr<FBBezierContour> testContour
   //  of potentially enclosing contours down to 1 or 0. Most times the first ray will find the
   //  correct answer, but in some degenerate
   //  cases it will take a few iterations.
+  //
+  // The number of times we go around the loop is fixed, rather than growing with the size of the
+  //  test contour in coordinate units, so huge contours don't cost more than small ones. If none
+  //  of the rays can decide, each remaining container is tested with a point of the test contour
+  //  that's clearly off the container's edges.
 
   static const FBFloat FBRayOverlap = 10.0;
+  static const std::size_t FBMaximumFraction = 8;
+
+  FBTraceLeafSpan span("containsContour", [&] {
+    return std::format("contour {} with {} edges, graph {}", testContour->bounds(), testContour->edges().size(),
+                       bounds());
+  });
 
   // Do a relatively cheap bounds test first
   if (!FBLineBoundsMightOverlap(bounds(), testContour->bounds())) {
@@ -706,19 +1303,17 @@ bool FBBezierGraph::containsContour(std::shared_ptr<FBBezierContour> testContour
   // Each time through the loop we split the test contour into any increasing amount of pieces
   //  (halves, thirds, quarters, etc) and send a ray along the boundaries. In order to increase
   //  our changes of eliminate all but 1 of the contours, we do both horizontal and vertical rays.
-  std::size_t count = std::max(static_cast<size_t>(ceil(FBWidth(testContour->bounds()))),
-                          static_cast<size_t>(ceil(FBHeight(testContour->bounds()))));
-  for (std::size_t fraction = 2; fraction <= (count * 2); fraction++) {
+  auto testBounds = testContour->bounds();
+  for (std::size_t fraction = 2; fraction <= FBMaximumFraction; fraction++) {
     auto didEliminate = false;
 
     // Send the horizontal rays through the test contour and (possibly) through parts of the graph
-    auto verticalSpacing = FBHeight(testContour->bounds()) / static_cast<FBFloat>(fraction);
-    for (auto y = FBMinY(testContour->bounds()) + verticalSpacing; y < FBMaxY(testContour->bounds());
-         y += verticalSpacing) {
+    auto verticalSpacing = FBHeight(testBounds) / static_cast<FBFloat>(fraction);
+    for (auto y = FBMinY(testBounds) + verticalSpacing; y < FBMaxY(testBounds); y += verticalSpacing) {
       // Construct a line that will reach outside both ends of both the test contour and graph
-      auto ray = std::make_shared<FBBezierCurve>(
-          FBMakePoint(std::min(FBMinX(bounds()), FBMinX(testContour->bounds())) - FBRayOverlap, y),
-          FBMakePoint(std::max(FBMaxX(bounds()), FBMaxX(testContour->bounds())) + FBRayOverlap, y));
+      auto ray = FBMakeShared<FBBezierCurve>(
+          FBMakePoint(std::min(FBMinX(bounds()), FBMinX(testBounds)) - FBRayOverlap, y),
+          FBMakePoint(std::max(FBMaxX(bounds()), FBMaxX(testBounds)) + FBRayOverlap, y));
       // Eliminate any contours that aren't containers. It's possible for this method to fail, so
       // check the return
       auto eliminated = eliminateContainers(containers, testContour, ray);
@@ -728,13 +1323,12 @@ bool FBBezierGraph::containsContour(std::shared_ptr<FBBezierContour> testContour
     }
 
     // Send the vertical rays through the test contour and (possibly) through parts of the graph
-    auto horizontalSpacing = FBWidth(testContour->bounds()) / static_cast<FBFloat>(fraction);
-    for (auto x = FBMinX(testContour->bounds()) + horizontalSpacing; x < FBMaxX(testContour->bounds());
-         x += horizontalSpacing) {
+    auto horizontalSpacing = FBWidth(testBounds) / static_cast<FBFloat>(fraction);
+    for (auto x = FBMinX(testBounds) + horizontalSpacing; x < FBMaxX(testBounds); x += horizontalSpacing) {
       // Construct a line that will reach outside both ends of both the test contour and graph
-      auto ray = std::make_shared<FBBezierCurve>(
-          FBMakePoint(x, std::min(FBMinY(bounds()), FBMinY(testContour->bounds())) - FBRayOverlap),
-          FBMakePoint(x, std::max(FBMaxY(bounds()), FBMaxY(testContour->bounds())) + FBRayOverlap));
+      auto ray = FBMakeShared<FBBezierCurve>(
+          FBMakePoint(x, std::min(FBMinY(bounds()), FBMinY(testBounds)) - FBRayOverlap),
+          FBMakePoint(x, std::max(FBMaxY(bounds()), FBMaxY(testBounds)) + FBRayOverlap));
       // Eliminate any contours that aren't containers. It's possible for this method to fail, so
       // check the return
       auto eliminated = eliminateContainers(containers, testContour, ray);
@@ -755,13 +1349,16 @@ bool FBBezierGraph::containsContour(std::shared_ptr<FBBezierContour> testContour
     }
   }
 
-  // This is a curious case, because by now we've sent rays that went through every integral
-  // cordinate of the test contour.
-  //  Despite that eliminateContainers: failed each time, meaning one container has a shared edge
-  //  for each ray test. It is likely
-  //  that contour is equal (the same) as the test contour. Return nil, because if it is equal, it
-  //  doesn't contain.
-  return false;
+  // This is a curious case: eliminateContainers: failed for every ray, meaning some container
+  //  shares an edge with the test contour, or has a joint, everywhere we looked. Decide container
+  //  by container instead. A container equal to the test contour doesn't contain it.
+  std::size_t containerCount = 0;
+  for (const auto &container : containers) {
+    if (!container->isEquivalent(testContour) && FBContourContainsContour(container, testContour)) {
+      containerCount++;
+    }
+  }
+  return (containerCount & 1) == 1;
 }
 
 bool FBBezierGraph::findBoundsOfContour(std::shared_ptr<FBBezierContour> testContour,
@@ -777,11 +1374,11 @@ bool FBBezierGraph::findBoundsOfContour(std::shared_ptr<FBBezierContour> testCon
   // First find all the intersections with the ray
   std::vector<std::shared_ptr<FBBezierIntersection>> rayIntersections;
   rayIntersections.reserve(9);
-  for (auto edge : testContour->edges()) {
-    ray->intersectionsWithBezierCurve(edge, nullptr,
-                                      [&](std::shared_ptr<FBBezierIntersection> intersection, bool *stop) {
-                                        rayIntersections.push_back(intersection);
-                                      });
+  for (const auto &edge : testContour->edges()) {
+    ray->rayIntersectionsWithBezierCurve(edge, nullptr,
+                                         [&](const std::shared_ptr<FBBezierIntersection> &intersection, bool *stop) {
+                                           rayIntersections.push_back(intersection);
+                                         });
   }
   if (rayIntersections.size() == 0) {
     return false; // shouldn't happen
@@ -825,11 +1422,11 @@ bool FBBezierGraph::findCrossingsOnContainers(const std::vector<std::shared_ptr<
   std::vector<std::shared_ptr<FBEdgeCrossing>> ambiguousCrossings;
   ambiguousCrossings.reserve(10);
   for (auto container : containers) {
-    for (auto containerEdge : container->edges()) {
+    for (const auto &containerEdge : container->edges()) {
       // See where the ray intersects this particular edge
       bool ambigious = false;
-      ray->intersectionsWithBezierCurve(
-          containerEdge, nullptr, [&](std::shared_ptr<FBBezierIntersection> intersection, bool *stop) {
+      ray->rayIntersectionsWithBezierCurve(
+          containerEdge, nullptr, [&](const std::shared_ptr<FBBezierIntersection> &intersection, bool *stop) {
             if (intersection->isTangent()) {
               return; // tangents don't count
             }
@@ -856,7 +1453,7 @@ bool FBBezierGraph::findCrossingsOnContainers(const std::vector<std::shared_ptr<
 
             // Creat a crossing for it so we know what edge it is associated
             // with. Don't insert it into a graph or anything though.
-            auto crossing = std::make_shared<FBEdgeCrossing>(intersection);
+            auto crossing = FBMakeShared<FBEdgeCrossing>(intersection);
             crossing->setEdge(containerEdge);
 
             // Special case if the bounds are just a point, and this crossing is
@@ -1048,9 +1645,9 @@ void FBBezierGraph::removeCrossings(std::vector<std::shared_ptr<FBEdgeCrossing>>
 
 void FBBezierGraph::markAllCrossingsAsUnprocessed() {
   for (auto contour : _contours) {
-    for (auto edge : contour->edges()) {
+    for (const auto &edge : contour->edges()) {
       edge->crossingsCopyWithBlock(
-          [](std::shared_ptr<FBEdgeCrossing> crossing, bool *stop) { crossing->setProcessed(false); });
+          [](const std::shared_ptr<FBEdgeCrossing> &crossing, bool *stop) { crossing->setProcessed(false); });
     }
   }
 }
@@ -1061,9 +1658,9 @@ std::shared_ptr<FBEdgeCrossing> FBBezierGraph::firstUnprocessedCrossing() {
   //  method.
 
   for (auto contour : _contours) {
-    for (auto edge : contour->edges()) {
+    for (const auto &edge : contour->edges()) {
       std::shared_ptr<FBEdgeCrossing> unprocessedCrossing = nullptr;
-      edge->crossingsWithBlock([&](std::shared_ptr<FBEdgeCrossing> crossing, bool *stop) {
+      edge->crossingsWithBlock([&](const std::shared_ptr<FBEdgeCrossing> &crossing, bool *stop) {
         if (crossing->isSelfCrossing()) {
           return;
         }
@@ -1091,13 +1688,13 @@ std::shared_ptr<FBBezierGraph> FBBezierGraph::bezierGraphFromIntersections() {
   //  other graph,
   //  and process it in the same way. Continue this until we reach a crossing that's been processed.
 
-  auto result = std::make_shared<FBBezierGraph>();
+  auto result = FBMakeShared<FBBezierGraph>();
 
   // Find the first crossing to start one
   auto crossing = firstUnprocessedCrossing();
   while (crossing != nullptr) {
     // This is the start of a contour, so create one
-    auto contour = std::make_shared<FBBezierContour>();
+    auto contour = FBMakeShared<FBBezierContour>();
     result->addContour(contour);
 
     // Keep going until we run into a crossing we've seen before.
@@ -1160,10 +1757,11 @@ void FBBezierGraph::removeCrossings() {
   // Crossings only make sense for the intersection between two specific graphs. In order for this
   //  graph to be usable in the future, remove all the crossings
   for (auto contour : _contours) {
-    for (auto edge : contour->edges()) {
+    for (const auto &edge : contour->edges()) {
       edge->removeAllCrossings();
     }
   }
+  _contourAdjacency = nullptr;
 }
 
 void FBBezierGraph::removeOverlaps() {
@@ -1182,8 +1780,8 @@ std::vector<std::shared_ptr<FBBezierContour>> FBBezierGraph::nonintersectingCont
   // Find all the contours that have no crossings on them.
   std::vector<std::shared_ptr<FBBezierContour>> contours;
   contours.reserve(_contours.size());
-  for (auto contour : this->contours()) {
-    if (contour->intersectingContours().size() == 0) {
+  for (const auto &contour : _contours) {
+    if (!_contourAdjacency->hasIntersectingContours(contour->adjacencyIndex())) {
       contours.push_back(contour);
     }
   }
@@ -1210,7 +1808,7 @@ FBBezierGraph::FBBezierGraph(const FBBezierPath &path) {
       wasClosed = false;
 
       // Start a new contour
-      contour = std::make_shared<FBBezierContour>();
+      contour = FBMakeShared<FBBezierContour>();
       this->addContour(contour);
 
       lastPoint = element.points[0];
@@ -1222,7 +1820,7 @@ FBBezierGraph::FBBezierGraph(const FBBezierPath &path) {
       if (!FBEqualPoints(element.points[0], lastPoint)) {
         // Convert lines to bezier curves as well. Just set control point to be in the line formed
         //  by the end points
-        contour->addCurve(std::make_shared<FBBezierCurve>(lastPoint, element.points[0]));
+        contour->addCurve(FBMakeShared<FBBezierCurve>(lastPoint, element.points[0]));
 
         lastPoint = element.points[0];
       }
@@ -1238,7 +1836,7 @@ FBBezierGraph::FBBezierGraph(const FBBezierPath &path) {
       }
 
       contour->addCurve(
-          std::make_shared<FBBezierCurve>(lastPoint, element.points[0], element.points[1], element.points[2]));
+          FBMakeShared<FBBezierCurve>(lastPoint, element.points[0], element.points[1], element.points[2]));
 
       lastPoint = element.points[2];
       break;
@@ -1256,7 +1854,7 @@ FBBezierGraph::FBBezierGraph(const FBBezierPath &path) {
 
         // Skip degenerate line segments
         if (!FBEqualPoints(lastPoint, firstPoint)) {
-          contour->addCurve(std::make_shared<FBBezierCurve>(lastPoint, firstPoint));
+          contour->addCurve(FBMakeShared<FBBezierCurve>(lastPoint, firstPoint));
           wasClosed = true;
         }
       }
@@ -1275,6 +1873,41 @@ FBBezierGraph::FBBezierGraph(const FBBezierPath &path) {
       _contours.end());
 }
 
+void FBBezierGraph::prepare() {
+  FBEdgeTable edges(_contours);
+  edges.prepareForConcurrentIntersections();
+  for (const auto &contour : _contours) {
+    contour->bounds();
+    contour->boundingRect();
+  }
+  bounds();
+  _spatialIndex = FBMakeSpatialIndex(edges);
+
+  // The hole or filled classification needs the self crossings in place. Take them, and the
+  //  shared end points they mark, out again so clones start clean.
+  _insidesClassified = false;
+  insertSelfCrossings();
+  _insidesClassified = true;
+  removeCrossings();
+  for (const auto &contour : _contours) {
+    for (const auto &edge : contour->edges()) {
+      edge->setStartShared(false);
+    }
+  }
+}
+
+std::shared_ptr<FBBezierGraph> FBBezierGraph::clone() const {
+  auto graph = FBMakeShared<FBBezierGraph>();
+  graph->_contours.reserve(_contours.size());
+  for (const auto &contour : _contours) {
+    graph->_contours.push_back(contour->clone());
+  }
+  graph->_bounds = _bounds;
+  graph->_insidesClassified = _insidesClassified;
+  graph->_spatialIndex = _spatialIndex;
+  return graph;
+}
+
 FBBezierPath FBBezierGraph::bezierPath() const {
   // Convert this graph into a bezier path. This is straightforward, each contour
   //  starting with a move to and each subsequent edge being translated by doing
@@ -33,15 +33,33 @@ OTHER DEALINGS IN THE SOFTWARE.
 
 namespace fb {
 
+class FBBezierGraph;
 class FBBezierPath;
 class FBBezierContour;
 class FBBezierCurve;
+class FBContourAdjacency;
 class FBEdgeCrossing;
+struct FBBooleanStats;
+struct FBGraphSpatialIndex;
+
+// The results of all four boolean operations between two graphs
+struct FBBooleanGraphResults {
+  std::shared_ptr<FBBezierGraph> unionGraph;
+  std::shared_ptr<FBBezierGraph> intersectGraph;
+  std::shared_ptr<FBBezierGraph> differenceGraph;
+  std::shared_ptr<FBBezierGraph> xorGraph;
+};
 
 class FBBezierGraph : public std::enable_shared_from_this<FBBezierGraph> {
 private:
   std::vector<std::shared_ptr<FBBezierContour>> _contours;
   mutable FBRect _bounds;
+  // Set by prepare(); shared, read only, with clones
+  bool _insidesClassified = false;
+  std::shared_ptr<const FBGraphSpatialIndex> _spatialIndex;
+  // Which contours cross which, shared with the other graph of the boolean operation while it has
+  //  crossings
+  std::shared_ptr<const FBContourAdjacency> _contourAdjacency;
 
 protected:
   std::shared_ptr<FBCurveLocation> closestLocationToPoint(const FBPoint &point);
@@ -55,6 +73,7 @@ protected:
   void removeCrossings();
   void removeOverlaps();
   void cleanupCrossingsWithBezierGraph(std::shared_ptr<FBBezierGraph> other);
+  void insertAndCleanupCrossingsWithBezierGraph(std::shared_ptr<FBBezierGraph> graph, FBBooleanStats *stats);
 
   void insertSelfCrossings();
   void markAllCrossingsAsUnprocessed();
@@ -70,13 +89,13 @@ protected:
       std::vector<std::shared_ptr<FBBezierContour>> &ourNonintersectingContours,
       std::vector<std::shared_ptr<FBBezierContour>> &theirNonintersectingContours,
       std::vector<std::shared_ptr<FBBezierContour>> &results);
+  void differenceNonintersectingPartsIntoGraph(std::shared_ptr<FBBezierGraph> result,
+                                               std::shared_ptr<FBBezierGraph> graph);
   void differenceEquivalentNonintersectingContours(
       std::vector<std::shared_ptr<FBBezierContour>> &ourNonintersectingContours,
       std::vector<std::shared_ptr<FBBezierContour>> &theirNonintersectingContours,
       std::vector<std::shared_ptr<FBBezierContour>> &results);
 
-  FBContourInside contourInsides(std::shared_ptr<FBBezierContour> contour);
-
   std::vector<std::shared_ptr<FBBezierContour>> nonintersectingContours();
   bool containsContour(std::shared_ptr<FBBezierContour> contour);
   bool eliminateContainers(std::vector<std::shared_ptr<FBBezierContour>> &containers,
@@ -106,10 +125,27 @@ public:
   void addContour(std::shared_ptr<FBBezierContour> contour);
   const std::vector<std::shared_ptr<FBBezierContour>> &contours() { return _contours; };
 
-  std::shared_ptr<FBBezierGraph> unionWithBezierGraph(std::shared_ptr<FBBezierGraph> graph);
-  std::shared_ptr<FBBezierGraph> intersectWithBezierGraph(std::shared_ptr<FBBezierGraph> graph);
-  std::shared_ptr<FBBezierGraph> differenceWithBezierGraph(std::shared_ptr<FBBezierGraph> graph);
-  std::shared_ptr<FBBezierGraph> xorWithBezierGraph(std::shared_ptr<FBBezierGraph> graph);
+  // The boolean operations. If stats isn't nullptr, the time spent in each phase and the sizes of
+  //  the graphs are added to it.
+  std::shared_ptr<FBBezierGraph> unionWithBezierGraph(std::shared_ptr<FBBezierGraph> graph,
+                                                      FBBooleanStats *stats = nullptr);
+  std::shared_ptr<FBBezierGraph> intersectWithBezierGraph(std::shared_ptr<FBBezierGraph> graph,
+                                                          FBBooleanStats *stats = nullptr);
+  std::shared_ptr<FBBezierGraph> differenceWithBezierGraph(std::shared_ptr<FBBezierGraph> graph,
+                                                           FBBooleanStats *stats = nullptr);
+  std::shared_ptr<FBBezierGraph> xorWithBezierGraph(std::shared_ptr<FBBezierGraph> graph,
+                                                    FBBooleanStats *stats = nullptr);
+  // All four boolean operations at once. The crossings between the graphs are only found once, so
+  //  this costs a lot less than running the operations one after the other.
+  FBBooleanGraphResults allBooleanResultsWithBezierGraph(std::shared_ptr<FBBezierGraph> graph,
+                                                         FBBooleanStats *stats = nullptr);
+
+  // Does the work that only depends on this graph up front: caches the bounds of the edges and
+  //  contours, classifies the contours as holes or filled regions, and builds a spatial index of
+  //  the edges. The boolean operations modify their graphs, so run them on clone()s of a prepared
+  //  graph; the clones share the classification and the index.
+  void prepare();
+  std::shared_ptr<FBBezierGraph> clone() const;
 
   std::string str(int indent = -1) const;
 };
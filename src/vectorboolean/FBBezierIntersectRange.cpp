@@ -25,6 +25,7 @@ OTHER DEALINGS IN THE SOFTWARE.
 */
 
 #include "FBBezierIntersectRange.hpp"
+#include "FBArena.hpp"
 #include "FBBezierCurve.hpp"
 
 namespace fb {
@@ -109,7 +110,7 @@ bool FBBezierIntersectRange::isAtStopOfCurve2() const {
 }
 
 std::shared_ptr<FBBezierIntersection> FBBezierIntersectRange::middleIntersection() const {
-  return std::make_shared<FBBezierIntersection>(_curve1, (_parameterRange1.minimum + _parameterRange1.maximum) / 2.0,
+  return FBMakeShared<FBBezierIntersection>(_curve1, (_parameterRange1.minimum + _parameterRange1.maximum) / 2.0,
                                                 _curve2, (_parameterRange2.minimum + _parameterRange2.maximum) / 2.0);
 }
 
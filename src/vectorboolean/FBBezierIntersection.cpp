@@ -39,6 +39,15 @@ bool FBBezierIntersection::isTangent() const {
     return false;
   }
 
+  // A straight line has the same tangent everywhere, its direction, so two lines don't need
+  //  splitting. They're tangent if they're parallel.
+  if (_curve1->isStraightLine() && _curve2->isStraightLine()) {
+    FBPoint curve1Tangent = FBNormalizePoint(FBSubtractPoint(_curve1->endPoint2(), _curve1->endPoint1()));
+    FBPoint curve2Tangent = FBNormalizePoint(FBSubtractPoint(_curve2->endPoint2(), _curve2->endPoint1()));
+    return FBArePointsCloseWithOptions(curve1Tangent, curve2Tangent, FBPointCloseThreshold) ||
+           FBArePointsCloseWithOptions(curve1Tangent, FBNegatePoint(curve2Tangent), FBPointCloseThreshold);
+  }
+
   computeCurve1();
   computeCurve2();
 
@@ -77,13 +86,22 @@ bool FBBezierIntersection::isAtStopOfCurve2() const {
 bool FBBezierIntersection::isAtEndPointOfCurve2() const { return isAtStartOfCurve2() || isAtStopOfCurve2(); }
 bool FBBezierIntersection::isAtEndPointOfCurve() const { return isAtEndPointOfCurve1() || isAtEndPointOfCurve2(); }
 
+void FBBezierIntersection::computeLocation() const {
+  if (!_needToComputeLocation) {
+    return;
+  }
+
+  _location = _curve1->locationAtParameter(_parameter1);
+
+  _needToComputeLocation = false;
+}
+
 void FBBezierIntersection::computeCurve1() const {
   if (!_needToComputeCurve1) {
     return;
   }
 
   auto result = _curve1->pointAtParameter(_parameter1);
-  _location = std::get<0>(result);
   _curve1LeftBezier = std::get<1>(result);
   _curve1RightBezier = std::get<2>(result);
 
@@ -96,7 +114,6 @@ void FBBezierIntersection::computeCurve2() const {
   }
 
   auto result = _curve2->pointAtParameter(_parameter2);
-  _location = std::get<0>(result);
   _curve2LeftBezier = std::get<1>(result);
   _curve2RightBezier = std::get<2>(result);
 
@@ -47,10 +47,12 @@ class FBBezierIntersection {
   mutable std::shared_ptr<FBBezierCurve> _curve1RightBezier = nullptr;
   mutable std::shared_ptr<FBBezierCurve> _curve2LeftBezier = nullptr;
   mutable std::shared_ptr<FBBezierCurve> _curve2RightBezier = nullptr;
+  mutable bool _needToComputeLocation = true;
   mutable bool _needToComputeCurve1 = true;
   mutable bool _needToComputeCurve2 = true;
 
 protected:
+  void computeLocation() const;
   void computeCurve1() const;
   void computeCurve2() const;
 
@@ -69,7 +71,7 @@ public:
   FBFloat parameter2() const { return _parameter2; }
 
   FBPoint location() const {
-    computeCurve1();
+    computeLocation();
     return _location;
   }
   bool isTangent() const;
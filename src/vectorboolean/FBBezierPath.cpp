@@ -25,7 +25,13 @@ OTHER DEALINGS IN THE SOFTWARE.
 */
 
 #include "FBBezierPath.hpp"
+#include "FBArena.hpp"
 #include "FBBezierGraph.hpp"
+#include "FBBooleanStats.hpp"
+#include "FBConcurrency.hpp"
+#include "FBFunctionRef.hpp"
+#include "FBPreparedPath.hpp"
+#include "FBRectilinear.hpp"
 
 #include <algorithm>
 #include <array>
@@ -201,28 +207,171 @@ void FBBezierPath::writeSVG(const std::string &filename) const {
   of.close();
 }
 
-FBBezierPath FBBezierPath::unionWithPath(const FBBezierPath &path) const {
-  auto graph1 = std::make_shared<fb::FBBezierGraph>(*this);
-  auto graph2 = std::make_shared<fb::FBBezierGraph>(path);
-  return graph1->unionWithBezierGraph(graph2)->bezierPath();
+static FBBezierPath FBBezierPathFromGraphs(const std::shared_ptr<FBBezierGraph> &graph) { return graph->bezierPath(); }
+
+static FBBooleanResults FBBezierPathFromGraphs(const FBBooleanGraphResults &graphs) {
+  return {graphs.unionGraph->bezierPath(), graphs.intersectGraph->bezierPath(), graphs.differenceGraph->bezierPath(),
+          graphs.xorGraph->bezierPath()};
+}
+
+// Runs operation, one of FBBezierGraph's boolean operations, on a graph of path and the graph
+//  makeGraph2 returns, and turns the resulting graph or graphs back into paths
+template <typename GraphOperation>
+static auto FBBooleanOperationWithGraphs(const FBBezierPath &path,
+                                         FBFunctionRef<std::shared_ptr<FBBezierGraph>()> makeGraph2,
+                                         GraphOperation operation, FBBooleanStats *stats) {
+  FBOperationArena arena; // the graphs are allocated from, and released with, this arena
+  std::shared_ptr<FBBezierGraph> graph1;
+  std::shared_ptr<FBBezierGraph> graph2;
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::buildGraphs, "buildGraphs");
+    graph1 = FBMakeShared<fb::FBBezierGraph>(path);
+    graph2 = makeGraph2();
+  }
+  auto resultGraphs = ((*graph1).*operation)(graph2, stats);
+  FBBooleanStatsTimer timer(stats, &FBBooleanStats::bezierPath, "bezierPath");
+  return FBBezierPathFromGraphs(resultGraphs);
+}
+
+using FBGraphOperation = std::shared_ptr<FBBezierGraph> (FBBezierGraph::*)(std::shared_ptr<FBBezierGraph> graph,
+                                                                           FBBooleanStats *stats);
+
+// Tries the rectilinear fast path before building graphs of the two paths
+static FBBezierPath FBBooleanOperationWithPaths(const FBBezierPath &path1, const FBBezierPath &path2,
+                                                FBBooleanOperation rectilinearOperation,
+                                                FBGraphOperation graphOperation, FBBooleanStats *stats) {
+  FBBezierPath result;
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::rectilinear, "rectilinear");
+    if (FBRectilinearBooleanOperation(path1, path2, rectilinearOperation, result)) {
+      return result;
+    }
+  }
+  return FBBooleanOperationWithGraphs(
+      path1, [&] { return FBMakeShared<fb::FBBezierGraph>(path2); }, graphOperation, stats);
+}
+
+FBBezierPath FBBezierPath::unionWithPath(const FBBezierPath &path, FBBooleanStats *stats) const {
+  return FBBooleanOperationWithPaths(*this, path, FBBooleanOperation::unite, &FBBezierGraph::unionWithBezierGraph,
+                                     stats);
+}
+
+FBBezierPath FBBezierPath::intersectWithPath(const FBBezierPath &path, FBBooleanStats *stats) const {
+  return FBBooleanOperationWithPaths(*this, path, FBBooleanOperation::intersect,
+                                     &FBBezierGraph::intersectWithBezierGraph, stats);
+}
+
+FBBezierPath FBBezierPath::differenceWithPath(const FBBezierPath &path, FBBooleanStats *stats) const {
+  return FBBooleanOperationWithPaths(*this, path, FBBooleanOperation::subtract,
+                                     &FBBezierGraph::differenceWithBezierGraph, stats);
+}
+
+FBBezierPath FBBezierPath::xorWithPath(const FBBezierPath &path, FBBooleanStats *stats) const {
+  return FBBooleanOperationWithPaths(*this, path, FBBooleanOperation::exclusiveOr, &FBBezierGraph::xorWithBezierGraph,
+                                     stats);
+}
+
+FBBezierPath FBBezierPath::unionWithPath(const FBPreparedPath &path, FBBooleanStats *stats) const {
+  return FBBooleanOperationWithGraphs(
+      *this, [&] { return path.graph(); }, &FBBezierGraph::unionWithBezierGraph, stats);
+}
+
+FBBezierPath FBBezierPath::intersectWithPath(const FBPreparedPath &path, FBBooleanStats *stats) const {
+  return FBBooleanOperationWithGraphs(
+      *this, [&] { return path.graph(); }, &FBBezierGraph::intersectWithBezierGraph, stats);
+}
+
+FBBezierPath FBBezierPath::differenceWithPath(const FBPreparedPath &path, FBBooleanStats *stats) const {
+  return FBBooleanOperationWithGraphs(
+      *this, [&] { return path.graph(); }, &FBBezierGraph::differenceWithBezierGraph, stats);
 }
 
-FBBezierPath FBBezierPath::intersectWithPath(const FBBezierPath &path) const {
-  auto graph1 = std::make_shared<fb::FBBezierGraph>(*this);
-  auto graph2 = std::make_shared<fb::FBBezierGraph>(path);
-  return graph1->intersectWithBezierGraph(graph2)->bezierPath();
+FBBezierPath FBBezierPath::xorWithPath(const FBPreparedPath &path, FBBooleanStats *stats) const {
+  return FBBooleanOperationWithGraphs(
+      *this, [&] { return path.graph(); }, &FBBezierGraph::xorWithBezierGraph, stats);
+}
+
+FBBooleanResults FBBezierPath::allBooleanResults(const FBBezierPath &path, FBBooleanStats *stats) const {
+  FBBooleanResults results;
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::rectilinear, "rectilinear");
+    if (FBRectilinearBooleanOperation(*this, path, FBBooleanOperation::unite, results.unionPath)
+        && FBRectilinearBooleanOperation(*this, path, FBBooleanOperation::intersect, results.intersectPath)
+        && FBRectilinearBooleanOperation(*this, path, FBBooleanOperation::subtract, results.differencePath)
+        && FBRectilinearBooleanOperation(*this, path, FBBooleanOperation::exclusiveOr, results.xorPath)) {
+      return results;
+    }
+  }
+  return FBBooleanOperationWithGraphs(
+      *this, [&] { return FBMakeShared<fb::FBBezierGraph>(path); }, &FBBezierGraph::allBooleanResultsWithBezierGraph,
+      stats);
+}
+
+using FBPathOperation = FBBezierPath (FBBezierPath::*)(const FBBezierPath &path, FBBooleanStats *stats) const;
+
+// Combines the paths two by two: paths 0 and 1 into result 0, 2 and 3 into result 1 and so on.
+//  An odd path out is carried over to the next level as is.
+static std::vector<FBBezierPath> FBReducePathLevel(std::span<const FBBezierPath> paths, FBPathOperation operation) {
+  std::vector<FBBezierPath> results((paths.size() + 1) / 2);
+  FBParallelFor(results.size(), 1, [&](std::size_t index) {
+    const auto &path1 = paths[index * 2];
+    if (index * 2 + 1 < paths.size()) {
+      results[index] = (path1.*operation)(paths[index * 2 + 1], nullptr);
+    } else {
+      results[index] = path1;
+    }
+  });
+  return results;
+}
+
+// Reduces the node of the tree FBReducePathLevel builds whose leaves start at paths[first], level
+//  levels up. It combines the two nodes below it, or carries the first one up as is when there's no
+//  second one, the same as the level by level reduction does.
+static FBBezierPath FBReducePathSubtree(std::span<const FBBezierPath> paths, std::size_t level, std::size_t first,
+                                        FBPathOperation operation) {
+  if (level == 0) {
+    return paths[first];
+  }
+  std::size_t half = std::size_t(1) << (level - 1);
+  auto path1 = FBReducePathSubtree(paths, level - 1, first, operation);
+  if (first + half >= paths.size()) {
+    return path1;
+  }
+  return (path1.*operation)(FBReducePathSubtree(paths, level - 1, first + half, operation), nullptr);
+}
+
+static FBBezierPath FBReducePaths(std::span<const FBBezierPath> paths, FBPathOperation operation) {
+  if (paths.empty()) {
+    return FBBezierPath();
+  }
+
+  // Each thread reduces whole subtrees, from the lowest level that still has a subtree for every
+  //  thread, so the threads only wait for each other on the few levels above that
+  std::size_t subtreeLevel = 0;
+  while ((std::size_t(1) << subtreeLevel) < paths.size()) {
+    subtreeLevel++;
+  }
+  auto subtreeCount = [&](std::size_t level) { return ((paths.size() - 1) >> level) + 1; };
+  while (subtreeLevel > 0 && subtreeCount(subtreeLevel) < FBThreadCount()) {
+    subtreeLevel--;
+  }
+
+  std::vector<FBBezierPath> level(subtreeCount(subtreeLevel));
+  FBParallelFor(level.size(), 1, [&](std::size_t index) {
+    level[index] = FBReducePathSubtree(paths, subtreeLevel, index << subtreeLevel, operation);
+  });
+  while (level.size() > 1) {
+    level = FBReducePathLevel(level, operation);
+  }
+  return std::move(level[0]);
 }
 
-FBBezierPath FBBezierPath::differenceWithPath(const FBBezierPath &path) const {
-  auto graph1 = std::make_shared<fb::FBBezierGraph>(*this);
-  auto graph2 = std::make_shared<fb::FBBezierGraph>(path);
-  return graph1->differenceWithBezierGraph(graph2)->bezierPath();
+FBBezierPath FBBezierPath::unionAll(std::span<const FBBezierPath> paths) {
+  return FBReducePaths(paths, &FBBezierPath::unionWithPath);
 }
 
-FBBezierPath FBBezierPath::xorWithPath(const FBBezierPath &path) const {
-  auto graph1 = std::make_shared<fb::FBBezierGraph>(*this);
-  auto graph2 = std::make_shared<fb::FBBezierGraph>(path);
-  return graph1->xorWithBezierGraph(graph2)->bezierPath();
+FBBezierPath FBBezierPath::intersectAll(std::span<const FBBezierPath> paths) {
+  return FBReducePaths(paths, &FBBezierPath::intersectWithPath);
 }
 
 std::string FBBezierPath::str(int indent) const {
@@ -30,10 +30,15 @@ OTHER DEALINGS IN THE SOFTWARE.
 
 #include <iostream>
 #include <array>
+#include <span>
 #include <vector>
 
 namespace fb {
 
+struct FBBooleanResults;
+struct FBBooleanStats;
+class FBPreparedPath;
+
 class FBBezierPath {
 public:
   enum class Type { move, line, curve, close };
@@ -59,6 +64,7 @@ public:
   void curveTo(const std::array<FBPoint, 3> &points);
   void close();
   std::size_t size() const { return _elements.size(); }
+  void reserve(std::size_t size) { _elements.reserve(size); }
   const Element &operator[](std::size_t i) const { return _elements[i]; }
 
   FBRect bounds() const;
@@ -66,14 +72,41 @@ public:
   std::string toSVG() const;
   void writeSVG(const std::string &filename) const;
 
-  FBBezierPath unionWithPath(const FBBezierPath &path) const;
-  FBBezierPath intersectWithPath(const FBBezierPath &path) const;
-  FBBezierPath differenceWithPath(const FBBezierPath &path) const;
-  FBBezierPath xorWithPath(const FBBezierPath &path) const;
+  // The boolean operations. If stats isn't nullptr, the time spent in each phase and the sizes of
+  //  the graphs are added to it.
+  FBBezierPath unionWithPath(const FBBezierPath &path, FBBooleanStats *stats = nullptr) const;
+  FBBezierPath intersectWithPath(const FBBezierPath &path, FBBooleanStats *stats = nullptr) const;
+  FBBezierPath differenceWithPath(const FBBezierPath &path, FBBooleanStats *stats = nullptr) const;
+  FBBezierPath xorWithPath(const FBBezierPath &path, FBBooleanStats *stats = nullptr) const;
+
+  FBBezierPath unionWithPath(const FBPreparedPath &path, FBBooleanStats *stats = nullptr) const;
+  FBBezierPath intersectWithPath(const FBPreparedPath &path, FBBooleanStats *stats = nullptr) const;
+  FBBezierPath differenceWithPath(const FBPreparedPath &path, FBBooleanStats *stats = nullptr) const;
+  FBBezierPath xorWithPath(const FBPreparedPath &path, FBBooleanStats *stats = nullptr) const;
+
+  // The results of all four boolean operations with path, computed together. The crossings between
+  //  the paths are only found once, so this costs a lot less than running the operations one after
+  //  the other.
+  FBBooleanResults allBooleanResults(const FBBezierPath &path, FBBooleanStats *stats = nullptr) const;
+
+  // Union or intersection of all the paths. The paths are combined pairwise in a balanced tree,
+  //  so the intermediate results stay small, and independent subtrees of the tree are combined on
+  //  FBThreadCount() threads. The tree's shape only depends on the number of paths, so the result
+  //  is the same whatever the thread count is. An empty span gives an empty path.
+  static FBBezierPath unionAll(std::span<const FBBezierPath> paths);
+  static FBBezierPath intersectAll(std::span<const FBBezierPath> paths);
 
   std::string str(int indent = -1) const;
 };
 
+// The results of all four boolean operations between two paths
+struct FBBooleanResults {
+  FBBezierPath unionPath;
+  FBBezierPath intersectPath;
+  FBBezierPath differencePath;
+  FBBezierPath xorPath;
+};
+
 std::ostream& operator<<(std::ostream& os, const FBBezierPath& path);
 
 } // namespace fb
\ No newline at end of file
@@ -0,0 +1,86 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "FBCommon.hpp"
+#include "FBTrace.hpp"
+
+#include <chrono>
+#include <cstddef>
+
+namespace fb {
+
+// FBBooleanStats is filled in by the boolean operations of FBBezierGraph, FBBezierPath and
+//  FBPreparedPath when one is passed to them, to see where an operation spends its time. Everything
+//  accumulates, so one FBBooleanStats can total up several operations.
+struct FBBooleanStats {
+  using Duration = std::chrono::steady_clock::duration;
+
+  // Wall time spent in each phase of the operations
+  Duration rectilinear{};             // the rectilinear fast path, for the operations it handles
+  Duration buildGraphs{};             // turning the paths into graphs, or cloning prepared ones
+  Duration insertCrossings{};         // insertCrossingsWithBezierGraph()
+  Duration insertSelfCrossings{};     // insertSelfCrossings(), on both graphs
+  Duration cleanupCrossings{};        // cleanupCrossingsWithBezierGraph()
+  Duration markCrossings{};           // marking the crossings as entries or exits, on both graphs
+  Duration intersections{};           // bezierGraphFromIntersections()
+  Duration nonintersectingContours{}; // deciding what to keep of the contours that cross nothing
+  Duration bezierPath{};              // turning the result back into a path
+
+  // The sizes of the graphs the operations worked on, both operands added together. The crossings
+  //  are counted once they've been cleaned up, on every edge they're on.
+  std::size_t edgeCount = 0;
+  std::size_t contourCount = 0;
+  std::size_t crossingCount = 0;
+};
+
+// Adds the wall time from its construction to its destruction to one of the phases of stats, and
+//  traces it as a span called name. The clock isn't read at all when stats is nullptr and there's
+//  no trace sink.
+class FBBooleanStatsTimer {
+  FBTraceSpan _span;
+  FBBooleanStats::Duration *_phase;
+  std::chrono::steady_clock::time_point _start;
+
+public:
+  FBBooleanStatsTimer(FBBooleanStats *stats, FBBooleanStats::Duration FBBooleanStats::*phase, const char *name)
+      : _span(name)
+      , _phase(stats != nullptr ? &(stats->*phase) : nullptr) {
+    if (_phase != nullptr) {
+      _start = std::chrono::steady_clock::now();
+    }
+  }
+  ~FBBooleanStatsTimer() {
+    if (_phase != nullptr) {
+      *_phase += std::chrono::steady_clock::now() - _start;
+    }
+  }
+  FBBooleanStatsTimer(const FBBooleanStatsTimer &) = delete;
+  FBBooleanStatsTimer &operator=(const FBBooleanStatsTimer &) = delete;
+};
+
+} // namespace fb
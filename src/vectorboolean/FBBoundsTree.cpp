@@ -0,0 +1,138 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FBBoundsTree.hpp"
+#include "FBGeometry.hpp"
+
+namespace fb {
+
+// Leaves hold at most this many rectangles
+static const uint32_t FBBoundsTreeLeafSize = 4;
+
+// Same tolerance FBLineBoundsMightOverlap() uses. Interior nodes are tested with it so they're
+//  never stricter than the exact test done on the rectangles in the leaves.
+static const FBFloat FBBoundsTreeClosenessThreshold = 1e-9;
+
+static bool FBBoundsTreeNodeMightOverlap(const FBPoint &minimum, const FBPoint &maximum, const FBRect &rect) {
+  FBFloat left = std::max(minimum.x, FBMinX(rect));
+  FBFloat right = std::min(maximum.x, FBMaxX(rect));
+  if (left - right > FBBoundsTreeClosenessThreshold) {
+    return false;
+  }
+  FBFloat top = std::max(minimum.y, FBMinY(rect));
+  FBFloat bottom = std::min(maximum.y, FBMaxY(rect));
+  return top - bottom <= FBBoundsTreeClosenessThreshold;
+}
+
+FBBoundsTree::FBBoundsTree(std::vector<FBRect> rects)
+    : _rects(std::move(rects)) {
+  if (_rects.empty()) {
+    return;
+  }
+  _order.resize(_rects.size());
+  for (uint32_t i = 0; i < _order.size(); i++) {
+    _order[i] = i;
+  }
+  _nodes.reserve(2 * (_rects.size() / FBBoundsTreeLeafSize + 1));
+  _nodes.resize(1);
+  buildNode(0, 0, static_cast<uint32_t>(_rects.size()));
+}
+
+void FBBoundsTree::buildNode(uint32_t nodeIndex, uint32_t first, uint32_t count) {
+  FBPoint minimum = {FBMinX(_rects[_order[first]]), FBMinY(_rects[_order[first]])};
+  FBPoint maximum = {FBMaxX(_rects[_order[first]]), FBMaxY(_rects[_order[first]])};
+  for (uint32_t i = first + 1; i < first + count; i++) {
+    const FBRect &rect = _rects[_order[i]];
+    minimum.x = std::min(minimum.x, FBMinX(rect));
+    minimum.y = std::min(minimum.y, FBMinY(rect));
+    maximum.x = std::max(maximum.x, FBMaxX(rect));
+    maximum.y = std::max(maximum.y, FBMaxY(rect));
+  }
+  _nodes[nodeIndex].minimum = minimum;
+  _nodes[nodeIndex].maximum = maximum;
+
+  if (count <= FBBoundsTreeLeafSize) {
+    _nodes[nodeIndex].first = first;
+    _nodes[nodeIndex].count = count;
+    return;
+  }
+
+  // Split at the median of the rectangle centers along the longer axis
+  bool splitX = (maximum.x - minimum.x) >= (maximum.y - minimum.y);
+  auto center = [&](uint32_t index) {
+    const FBRect &rect = _rects[index];
+    return splitX ? FBMinX(rect) + FBMaxX(rect) : FBMinY(rect) + FBMaxY(rect);
+  };
+  uint32_t half = count / 2;
+  std::nth_element(_order.begin() + first, _order.begin() + first + half, _order.begin() + first + count,
+                   [&](uint32_t index1, uint32_t index2) {
+                     FBFloat center1 = center(index1);
+                     FBFloat center2 = center(index2);
+                     return center1 < center2 || (center1 == center2 && index1 < index2);
+                   });
+
+  // The children are always allocated next to each other, so only the left one is recorded
+  uint32_t left = static_cast<uint32_t>(_nodes.size());
+  _nodes.resize(_nodes.size() + 2);
+  _nodes[nodeIndex].first = left;
+  buildNode(left, first, half);
+  buildNode(left + 1, first + half, count - half);
+}
+
+void FBBoundsTree::overlappingIndices(const FBRect &rect, std::vector<std::size_t> &indices) const {
+  if (_nodes.empty()) {
+    return;
+  }
+
+  size_t firstFound = indices.size();
+  uint32_t stack[64];
+  size_t stackSize = 0;
+  stack[stackSize++] = 0;
+  while (stackSize > 0) {
+    const Node &node = _nodes[stack[--stackSize]];
+    if (!FBBoundsTreeNodeMightOverlap(node.minimum, node.maximum, rect)) {
+      continue;
+    }
+    if (node.count > 0) {
+      for (uint32_t i = node.first; i < node.first + node.count; i++) {
+        if (FBLineBoundsMightOverlap(_rects[_order[i]], rect)) {
+          indices.push_back(_order[i]);
+        }
+      }
+      continue;
+    }
+    stack[stackSize++] = node.first + 1;
+    stack[stackSize++] = node.first;
+  }
+
+  std::sort(indices.begin() + firstFound, indices.end());
+}
+
+bool FBBoundsTree::mightOverlap(const FBRect &rect) const {
+  return !_nodes.empty() && FBBoundsTreeNodeMightOverlap(_nodes[0].minimum, _nodes[0].maximum, rect);
+}
+
+} // namespace fb
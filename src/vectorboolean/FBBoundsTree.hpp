@@ -0,0 +1,67 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "FBCommon.hpp"
+
+#include <cstdint>
+
+namespace fb {
+
+// FBBoundsTree is a static bounding volume hierarchy over a list of rectangles, used as a
+//  broadphase so we only run the expensive curve intersection code on edges whose bounding
+//  rects might overlap. The tree is built once and then queried; it reports the indices of the
+//  rectangles it was built from. A rectangle is reported if, and only if,
+//  FBLineBoundsMightOverlap() says it might overlap the query rectangle, so culling with the
+//  tree never changes which pairs of curves can intersect.
+class FBBoundsTree {
+  struct Node {
+    FBPoint minimum;
+    FBPoint maximum;
+    uint32_t first = 0; // index into _order of the first item (leaf) or the left child (interior)
+    uint32_t count = 0; // number of items in a leaf, zero for interior nodes
+  };
+
+  std::vector<FBRect> _rects;
+  std::vector<uint32_t> _order;
+  std::vector<Node> _nodes;
+
+  void buildNode(uint32_t nodeIndex, uint32_t first, uint32_t count);
+
+public:
+  FBBoundsTree() = default;
+  FBBoundsTree(std::vector<FBRect> rects);
+
+  std::size_t size() const { return _rects.size(); }
+  const FBRect &rect(std::size_t index) const { return _rects[index]; }
+
+  // Appends the indices of all rectangles that might overlap rect to indices, in increasing order.
+  void overlappingIndices(const FBRect &rect, std::vector<std::size_t> &indices) const;
+  bool mightOverlap(const FBRect &rect) const;
+};
+
+} // namespace fb
@@ -0,0 +1,197 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FBConcurrency.hpp"
+#include "FBIntersectionCounters.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fb {
+
+static std::atomic<std::size_t> FBConfiguredThreadCount{1};
+// Set on the threads running the blocks of a FBParallelFor
+static thread_local bool FBIsInsideParallelFor = false;
+
+// Work is handed out in chunks of this many indices to keep contention on the counter low
+static const std::size_t FBParallelForChunkSize = 16;
+
+void FBSetThreadCount(std::size_t threadCount) { FBConfiguredThreadCount.store(threadCount); }
+
+std::size_t FBThreadCount() {
+  std::size_t threadCount = FBConfiguredThreadCount.load();
+  if (threadCount == 0) {
+    threadCount = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  }
+  return threadCount;
+}
+
+namespace {
+
+// One call of FBParallelFor, shared by the calling thread and the pool threads helping it
+struct FBParallelJob {
+  FBFunctionRef<void(std::size_t index)> block;
+  std::size_t count = 0;
+  std::size_t chunkSize = 0;
+  std::atomic<std::size_t> nextIndex{0};
+  bool isCounting = false;
+
+  // Guarded by the pool's mutex
+  std::size_t helperCount = 0;       // pool threads that have joined the job
+  std::size_t maximumHelperCount = 0;
+  std::size_t activeHelperCount = 0; // pool threads still working on it
+  FBIntersectionCounters helperCounters;
+
+  FBParallelJob(FBFunctionRef<void(std::size_t index)> block, std::size_t count, std::size_t chunkSize)
+      : block(block), count(count), chunkSize(chunkSize) {}
+
+  void work() {
+    while (true) {
+      std::size_t first = nextIndex.fetch_add(chunkSize);
+      if (first >= count) {
+        break;
+      }
+      std::size_t last = std::min(count, first + chunkSize);
+      for (std::size_t index = first; index < last; index++) {
+        block(index);
+      }
+    }
+  }
+};
+
+// The threads that help the calling threads of FBParallelFor. Jobs wait in a queue until they have
+//  as many helpers as they want, or until their calling thread has handed out all the indices.
+class FBWorkerPool {
+  std::mutex _mutex;
+  std::condition_variable _jobAdded;
+  std::condition_variable _helperFinished;
+  std::deque<FBParallelJob *> _jobs;
+  std::vector<std::thread> _threads;
+  bool _isStopping = false;
+
+  void runHelper() {
+    FBIsInsideParallelFor = true;
+    std::unique_lock lock(_mutex);
+    while (true) {
+      _jobAdded.wait(lock, [&] { return _isStopping || !_jobs.empty(); });
+      if (_isStopping) {
+        return;
+      }
+      auto job = _jobs.front();
+      if (++job->helperCount == job->maximumHelperCount) {
+        _jobs.pop_front();
+      }
+      job->activeHelperCount++;
+      lock.unlock();
+
+      FBIntersectionCounters counters;
+      {
+        FBIntersectionCountersScope countersScope(job->isCounting ? &counters : nullptr);
+        job->work();
+      }
+
+      lock.lock();
+      job->helperCounters += counters;
+      if (--job->activeHelperCount == 0) {
+        _helperFinished.notify_all();
+      }
+    }
+  }
+
+public:
+  ~FBWorkerPool() {
+    {
+      std::lock_guard lock(_mutex);
+      _isStopping = true;
+    }
+    _jobAdded.notify_all();
+    for (auto &thread : _threads) {
+      thread.join();
+    }
+  }
+
+  // Runs job on the calling thread and up to helperCount pool threads
+  void run(FBParallelJob &job, std::size_t helperCount) {
+    {
+      std::lock_guard lock(_mutex);
+      while (_threads.size() < helperCount) {
+        _threads.emplace_back([this] { runHelper(); });
+      }
+      job.maximumHelperCount = helperCount;
+      _jobs.push_back(&job);
+    }
+    _jobAdded.notify_all();
+
+    bool wasInsideParallelFor = FBIsInsideParallelFor;
+    FBIsInsideParallelFor = true;
+    job.work();
+    FBIsInsideParallelFor = wasInsideParallelFor;
+
+    // Every index has been handed out, so no more helpers may join. Wait for the ones that did.
+    std::unique_lock lock(_mutex);
+    std::erase(_jobs, &job);
+    _helperFinished.wait(lock, [&] { return job.activeHelperCount == 0; });
+  }
+};
+
+} // namespace
+
+static FBWorkerPool &FBSharedWorkerPool() {
+  static FBWorkerPool pool;
+  return pool;
+}
+
+void FBParallelFor(std::size_t count, FBFunctionRef<void(std::size_t index)> block) {
+  FBParallelFor(count, FBParallelForChunkSize, block);
+}
+
+void FBParallelFor(std::size_t count, std::size_t chunkSize, FBFunctionRef<void(std::size_t index)> block) {
+  chunkSize = std::max<std::size_t>(1, chunkSize);
+  std::size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+  std::size_t threadCount = std::min(FBThreadCount(), chunkCount);
+  if (threadCount <= 1 || FBIsInsideParallelFor) {
+    for (std::size_t index = 0; index < count; index++) {
+      block(index);
+    }
+    return;
+  }
+
+  // The pool threads count their work separately, if the calling thread is counting, and it's
+  //  added to the calling thread's counters once they're done
+  auto counters = FBIntersectionCounters::current();
+  FBParallelJob job(block, count, chunkSize);
+  job.isCounting = counters != nullptr;
+  FBSharedWorkerPool().run(job, threadCount - 1);
+  if (counters != nullptr) {
+    *counters += job.helperCounters;
+  }
+}
+
+} // namespace fb
@@ -0,0 +1,50 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "FBCommon.hpp"
+#include "FBFunctionRef.hpp"
+
+namespace fb {
+
+// Number of threads the boolean operations may use to search for crossings. The default of 1
+//  keeps all the work on the calling thread. 0 means one thread per hardware thread. The results
+//  of the boolean operations are identical whatever the thread count is.
+void FBSetThreadCount(std::size_t threadCount);
+std::size_t FBThreadCount();
+
+// Calls block once for every index in [0, count), spread over FBThreadCount() threads. The
+//  calling thread takes part in the work, and the function returns when all of it is done. The
+//  other threads come from a pool that's started the first time it's needed and kept for the life
+//  of the process, so a call doesn't create any threads. block must be safe to call concurrently
+//  for different indices. Indices are handed out chunkSize at a time; the first form uses a chunk
+//  size suited to cheap blocks. A FBParallelFor called from inside the block of another one runs
+//  on the calling thread, so nesting them doesn't multiply the number of threads.
+void FBParallelFor(std::size_t count, FBFunctionRef<void(std::size_t index)> block);
+void FBParallelFor(std::size_t count, std::size_t chunkSize, FBFunctionRef<void(std::size_t index)> block);
+
+} // namespace fb
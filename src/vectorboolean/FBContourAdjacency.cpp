@@ -0,0 +1,105 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FBContourAdjacency.hpp"
+#include "FBBezierContour.hpp"
+#include "FBBezierCurve.hpp"
+#include "FBEdgeCrossing.hpp"
+
+namespace fb {
+
+// The root of contour's union-find tree, halving the path on the way up
+static FBContourAdjacency::Index FBFindComponentRoot(std::vector<FBContourAdjacency::Index> &parents,
+                                                     FBContourAdjacency::Index contour) {
+  while (parents[contour] != contour) {
+    parents[contour] = parents[parents[contour]];
+    contour = parents[contour];
+  }
+  return contour;
+}
+
+FBContourAdjacency::FBContourAdjacency(const std::vector<std::shared_ptr<FBBezierContour>> &ourContours,
+                                       const std::vector<std::shared_ptr<FBBezierContour>> &theirContours) {
+  _contours.reserve(ourContours.size() + theirContours.size());
+  _contours.insert(_contours.end(), ourContours.begin(), ourContours.end());
+  _contours.insert(_contours.end(), theirContours.begin(), theirContours.end());
+  for (Index index = 0; index < contourCount(); index++) {
+    _contours[index]->setAdjacencyIndex(index);
+  }
+
+  // One pass over the crossings: the ones between the graphs go in the contour's row, the self
+  //  crossings join the two contours' components.
+  std::vector<Index> parents(contourCount());
+  for (Index index = 0; index < contourCount(); index++) {
+    parents[index] = index;
+  }
+  static const Index FBNoContour = UINT32_MAX;
+  std::vector<Index> lastAddedBy(contourCount(), FBNoContour);
+  _intersectingFirst.reserve(contourCount() + 1);
+  for (Index index = 0; index < contourCount(); index++) {
+    _intersectingFirst.push_back(static_cast<Index>(_intersecting.size()));
+    for (const auto &edge : _contours[index]->edges()) {
+      edge->crossingsWithBlock([&](const std::shared_ptr<FBEdgeCrossing> &crossing, bool *stop) {
+        auto other = static_cast<Index>(crossing->counterpart()->edge()->contour()->adjacencyIndex());
+        if (crossing->isSelfCrossing()) {
+          auto root1 = FBFindComponentRoot(parents, index);
+          auto root2 = FBFindComponentRoot(parents, other);
+          parents[std::max(root1, root2)] = std::min(root1, root2);
+        } else if (lastAddedBy[other] != index) {
+          lastAddedBy[other] = index;
+          _intersecting.push_back(other);
+        }
+      });
+    }
+  }
+  _intersectingFirst.push_back(static_cast<Index>(_intersecting.size()));
+
+  // Number the components in the order of their lowest contour, then list their contours
+  _component.resize(contourCount());
+  std::vector<Index> componentSizes;
+  for (Index index = 0; index < contourCount(); index++) {
+    auto root = FBFindComponentRoot(parents, index);
+    if (root == index) {
+      _component[index] = static_cast<Index>(componentSizes.size());
+      componentSizes.push_back(0);
+    } else {
+      _component[index] = _component[root]; // the root is lower, so already numbered
+    }
+    componentSizes[_component[index]]++;
+  }
+  _componentFirst.reserve(componentSizes.size() + 1);
+  _componentFirst.push_back(0);
+  for (auto size : componentSizes) {
+    _componentFirst.push_back(_componentFirst.back() + size);
+  }
+  _componentContours.resize(contourCount());
+  std::vector<Index> nextSlot(_componentFirst.begin(), _componentFirst.end() - 1);
+  for (Index index = 0; index < contourCount(); index++) {
+    _componentContours[nextSlot[_component[index]]++] = index;
+  }
+}
+
+} // namespace fb
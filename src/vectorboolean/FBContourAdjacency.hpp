@@ -0,0 +1,87 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "FBCommon.hpp"
+
+#include <cstdint>
+#include <span>
+
+namespace fb {
+
+class FBBezierContour;
+
+// FBContourAdjacency records which contours cross which for the two graphs of one boolean
+//  operation. It's built once the crossings have been inserted and cleaned up, so marking the
+//  crossings and sorting out the nonintersecting contours don't have to walk every crossing of a
+//  contour each time they ask what it crosses. The contours are numbered densely, the first graph's
+//  before the second's, and each contour is told its number (see FBBezierContour::adjacencyIndex()).
+//  The crossings between the graphs are kept as a compressed sparse row list per contour. The
+//  self crossings within a graph are collapsed into components: contours that cross each other,
+//  directly or through other contours, share one. It must be rebuilt if crossings are added or
+//  removed.
+class FBContourAdjacency {
+public:
+  using Index = uint32_t;
+
+private:
+  std::vector<std::shared_ptr<FBBezierContour>> _contours;
+  // The other graph's contours that contour i crosses are
+  //  _intersecting[_intersectingFirst[i], _intersectingFirst[i + 1]), in the order they're met
+  //  walking its edges' crossings
+  std::vector<Index> _intersectingFirst;
+  std::vector<Index> _intersecting;
+  // The contours of component c are _componentContours[_componentFirst[c], _componentFirst[c + 1])
+  std::vector<Index> _component;
+  std::vector<Index> _componentFirst;
+  std::vector<Index> _componentContours;
+
+public:
+  FBContourAdjacency(const std::vector<std::shared_ptr<FBBezierContour>> &ourContours,
+                     const std::vector<std::shared_ptr<FBBezierContour>> &theirContours);
+
+  Index contourCount() const { return static_cast<Index>(_contours.size()); }
+  const std::shared_ptr<FBBezierContour> &contour(Index contour) const { return _contours[contour]; }
+
+  // The contours of the other graph this contour crosses
+  std::span<const Index> intersectingContours(Index contour) const {
+    return std::span(_intersecting).subspan(_intersectingFirst[contour],
+                                            _intersectingFirst[contour + 1] - _intersectingFirst[contour]);
+  }
+  bool hasIntersectingContours(Index contour) const {
+    return _intersectingFirst[contour] != _intersectingFirst[contour + 1];
+  }
+
+  // The contour and every contour of its own graph it self intersects with, directly or not
+  Index component(Index contour) const { return _component[contour]; }
+  std::span<const Index> componentContours(Index component) const {
+    return std::span(_componentContours)
+        .subspan(_componentFirst[component], _componentFirst[component + 1] - _componentFirst[component]);
+  }
+};
+
+} // namespace fb
@@ -26,6 +26,7 @@ OTHER DEALINGS IN THE SOFTWARE.
 
 #include "FBContourOverlap.hpp"
 
+#include "FBArena.hpp"
 #include "FBBezierContour.hpp"
 #include "FBBezierCurve.hpp"
 #include "FBBezierIntersectRange.hpp"
@@ -133,7 +134,7 @@ static void FBComputeEdge1TestPoints(std::shared_ptr<FBEdgeOverlap> firstOverlap
 
 void FBContourOverlap::addOverlap(std::shared_ptr<FBBezierIntersectRange> range, std::shared_ptr<FBBezierCurve> edge1,
                                   std::shared_ptr<FBBezierCurve> edge2) {
-  auto overlap = std::make_shared<FBEdgeOverlap>(range, edge1, edge2);
+  auto overlap = FBMakeShared<FBEdgeOverlap>(range, edge1, edge2);
   bool createNewRun = false;
   if (_runs.size() == 0) {
     createNewRun = true;
@@ -148,7 +149,7 @@ void FBContourOverlap::addOverlap(std::shared_ptr<FBBezierIntersectRange> range,
     createNewRun = !inserted;
   }
   if (createNewRun) {
-    auto run = std::make_shared<FBEdgeOverlapRun>();
+    auto run = FBMakeShared<FBEdgeOverlapRun>();
     run->insertOverlap(overlap);
     _runs.push_back(run);
   }
@@ -172,7 +173,8 @@ bool FBContourOverlap::doesContainParameter(FBFloat parameter, std::shared_ptr<F
   return false;
 }
 
-void FBContourOverlap::runsWithBlock(std::function<void(std::shared_ptr<FBEdgeOverlapRun> run, bool *stop)> block) {
+void FBContourOverlap::runsWithBlock(
+    FBFunctionRef<void(const std::shared_ptr<FBEdgeOverlapRun> &run, bool *stop)> block) {
   bool stop = false;
   for (auto &run : _runs) {
     block(run, &stop);
@@ -394,8 +396,8 @@ bool FBEdgeOverlap::fitsAfter(std::shared_ptr<FBEdgeOverlap> previousOverlap) {
 
 void FBEdgeOverlap::addMiddleCrossing() {
   auto intersection = _range->middleIntersection();
-  auto ourCrossing = std::make_shared<FBEdgeCrossing>(intersection);
-  auto theirCrossing = std::make_shared<FBEdgeCrossing>(intersection);
+  auto ourCrossing = FBMakeShared<FBEdgeCrossing>(intersection);
+  auto theirCrossing = FBMakeShared<FBEdgeCrossing>(intersection);
   ourCrossing->setCounterpart(theirCrossing);
   theirCrossing->setCounterpart(ourCrossing);
   ourCrossing->setFromCrossingOverlap(true);
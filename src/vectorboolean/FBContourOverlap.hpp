@@ -27,6 +27,7 @@ OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 #include "FBCommon.hpp"
+#include "FBFunctionRef.hpp"
 
 namespace fb {
 
@@ -83,7 +84,7 @@ public:
 
   void addOverlap(std::shared_ptr<FBBezierIntersectRange> range, std::shared_ptr<FBBezierCurve> edge1,
                   std::shared_ptr<FBBezierCurve> edge2);
-  void runsWithBlock(std::function<void(std::shared_ptr<FBEdgeOverlapRun> run, bool *stop)> block);
+  void runsWithBlock(FBFunctionRef<void(const std::shared_ptr<FBEdgeOverlapRun> &run, bool *stop)> block);
 
   void reset();
 
@@ -31,6 +31,15 @@ OTHER DEALINGS IN THE SOFTWARE.
 
 namespace fb {
 
+void FBEdgeCrossing::setEdge(std::shared_ptr<FBBezierCurve> edge) {
+  _edge = edge;
+  // A crossing removed from its edge keeps the side it was on
+  if (edge != nullptr) {
+    _onCurve1 = edge == _intersection->curve1();
+    _parameter = _onCurve1 ? _intersection->parameter1() : _intersection->parameter2();
+  }
+}
+
 void FBEdgeCrossing::removeFromEdge() {
   if (!_edge.expired()) {
     _edge.lock()->removeCrossing(shared_from_this());
@@ -67,14 +76,6 @@ std::shared_ptr<FBEdgeCrossing> FBEdgeCrossing::previousNonself() {
   return previous;
 }
 
-FBFloat FBEdgeCrossing::parameter() {
-  if (_edge.lock() == _intersection->curve1()) {
-    return _intersection->parameter1();
-  }
-
-  return _intersection->parameter2();
-}
-
 FBPoint FBEdgeCrossing::location() { return _intersection->location(); }
 
 std::shared_ptr<FBBezierCurve> FBEdgeCrossing::curve() { return _edge.lock(); }
@@ -84,7 +85,7 @@ std::shared_ptr<FBBezierCurve> FBEdgeCrossing::leftCurve() {
     return nullptr;
   }
 
-  if (_edge.lock() == _intersection->curve1()) {
+  if (_onCurve1) {
     return _intersection->curve1LeftBezier();
   }
 
@@ -96,7 +97,7 @@ std::shared_ptr<FBBezierCurve> FBEdgeCrossing::rightCurve() {
     return nullptr;
   }
 
-  if (_edge.lock() == _intersection->curve1()) {
+  if (_onCurve1) {
     return _intersection->curve1RightBezier();
   }
 
@@ -104,7 +105,7 @@ std::shared_ptr<FBBezierCurve> FBEdgeCrossing::rightCurve() {
 }
 
 bool FBEdgeCrossing::isAtStart() {
-  if (_edge.lock() == _intersection->curve1()) {
+  if (_onCurve1) {
     return _intersection->isAtStartOfCurve1();
   }
 
@@ -112,7 +113,7 @@ bool FBEdgeCrossing::isAtStart() {
 }
 
 bool FBEdgeCrossing::isAtEnd() {
-  if (_edge.lock() == _intersection->curve1()) {
+  if (_onCurve1) {
     return _intersection->isAtStopOfCurve1();
   }
 
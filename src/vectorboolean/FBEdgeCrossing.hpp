@@ -41,11 +41,15 @@ class FBEdgeCrossing : public std::enable_shared_from_this<FBEdgeCrossing> {
   std::shared_ptr<FBBezierIntersection> _intersection;
   std::weak_ptr<FBBezierCurve> _edge;
   std::weak_ptr<FBEdgeCrossing> _counterpart;
-  bool _fromCrossingOverlap;
-  bool _entry;
-  bool _processed;
-  bool _selfCrossing;
-  size_t _index;
+  bool _fromCrossingOverlap = false;
+  bool _entry = false;
+  bool _processed = false;
+  bool _selfCrossing = false;
+  size_t _index = 0;
+  // Which side of the intersection this crossing is on, and its parameter there. Cached by setEdge()
+  //  so sorting and walking the crossings don't have to lock _edge.
+  bool _onCurve1 = false;
+  FBFloat _parameter = 0.0;
 
 public:
   FBEdgeCrossing(std::shared_ptr<FBBezierIntersection> intersection)
@@ -53,10 +57,10 @@ public:
   void removeFromEdge();
 
   std::shared_ptr<FBBezierCurve> edge() const { return _edge.lock(); }
-  void setEdge(std::shared_ptr<FBBezierCurve> edge) { _edge = edge; }
+  void setEdge(std::shared_ptr<FBBezierCurve> edge);
   std::shared_ptr<FBEdgeCrossing> counterpart() const { return _counterpart.lock(); }
   void setCounterpart(std::shared_ptr<FBEdgeCrossing> counterpart) { _counterpart = counterpart; }
-  FBFloat order() { return parameter(); };
+  FBFloat order() const { return _parameter; };
   bool isEntry() const { return _entry; }
   void setEntry(bool entry) { _entry = entry; }
   bool isProcessed() const { return _processed; }
@@ -73,7 +77,7 @@ public:
   std::shared_ptr<FBEdgeCrossing> nextNonself();
   std::shared_ptr<FBEdgeCrossing> previousNonself();
 
-  FBFloat parameter();
+  FBFloat parameter() const { return _parameter; }
   std::shared_ptr<FBBezierCurve> curve();
   std::shared_ptr<FBBezierCurve> leftCurve();
   std::shared_ptr<FBBezierCurve> rightCurve();
@@ -0,0 +1,93 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FBEdgeTable.hpp"
+#include "FBBezierContour.hpp"
+#include "FBBezierCurve.hpp"
+#include "FBGeometry.hpp"
+
+namespace fb {
+
+FBEdgeTable::FBEdgeTable(const std::vector<std::shared_ptr<FBBezierContour>> &contours) {
+  size_t edgeCount = 0;
+  for (const auto &contour : contours) {
+    edgeCount += contour->edges().size();
+  }
+  for (size_t i = 0; i < 4; i++) {
+    _x[i].reserve(edgeCount);
+    _y[i].reserve(edgeCount);
+  }
+  _isStraightLine.reserve(edgeCount);
+  _boundingX.reserve(edgeCount);
+  _boundingY.reserve(edgeCount);
+  _boundingWidth.reserve(edgeCount);
+  _boundingHeight.reserve(edgeCount);
+  _edgeContour.reserve(edgeCount);
+  _curves.reserve(edgeCount);
+  _contourFirstEdge.reserve(contours.size() + 1);
+  _contourBoundingRects.reserve(contours.size());
+  _contours = contours;
+
+  for (size_t contourIndex = 0; contourIndex < contours.size(); contourIndex++) {
+    _contourFirstEdge.push_back(static_cast<Index>(_curves.size()));
+    FBRect contourBounds = FBZeroRect;
+    bool firstEdge = true;
+    for (const auto &edge : contours[contourIndex]->edges()) {
+      const auto &data = edge->data();
+      _x[0].push_back(data.endPoint1.x);
+      _y[0].push_back(data.endPoint1.y);
+      _x[1].push_back(data.controlPoint1.x);
+      _y[1].push_back(data.controlPoint1.y);
+      _x[2].push_back(data.controlPoint2.x);
+      _y[2].push_back(data.controlPoint2.y);
+      _x[3].push_back(data.endPoint2.x);
+      _y[3].push_back(data.endPoint2.y);
+      _isStraightLine.push_back(data.isStraightLine ? 1 : 0);
+
+      FBRect bounds = edge->boundingRect();
+      _boundingX.push_back(bounds.origin.x);
+      _boundingY.push_back(bounds.origin.y);
+      _boundingWidth.push_back(bounds.size.width);
+      _boundingHeight.push_back(bounds.size.height);
+      contourBounds = firstEdge ? bounds : FBUnionRect(contourBounds, bounds);
+      firstEdge = false;
+
+      _edgeContour.push_back(static_cast<Index>(contourIndex));
+      _curves.push_back(edge);
+    }
+    _contourBoundingRects.push_back(contourBounds);
+  }
+  _contourFirstEdge.push_back(static_cast<Index>(_curves.size()));
+}
+
+void FBEdgeTable::prepareForConcurrentIntersections() const {
+  for (const auto &curve : _curves) {
+    curve->boundingRect();
+    curve->bounds();
+  }
+}
+
+} // namespace fb
@@ -0,0 +1,99 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "FBCommon.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace fb {
+
+class FBBezierContour;
+class FBBezierCurve;
+
+// FBEdgeTable is a flat, index based snapshot of the edges of a list of contours (usually all the
+//  contours of an FBBezierGraph), taken at the start of the phases of a boolean operation that
+//  walk every edge. Edges are numbered with 32-bit indices contour by contour, so the edges of a
+//  contour are a contiguous range and comparing edge indices compares (contour, edge) positions.
+//  The control points and bounding rects are kept in structure of arrays layout so sweeping over
+//  them doesn't chase any pointers or touch any reference counts. The table keeps references to
+//  the curves and contours it was built from, which remain the authoritative graph; it must be
+//  rebuilt if the contours are edited.
+class FBEdgeTable {
+public:
+  using Index = uint32_t;
+
+private:
+  // Control points, one column per coordinate: endPoint1, controlPoint1, controlPoint2, endPoint2
+  std::array<std::vector<FBFloat>, 4> _x;
+  std::array<std::vector<FBFloat>, 4> _y;
+  std::vector<uint8_t> _isStraightLine;
+  // Bounding rects of the edges, exactly as FBBezierCurve::boundingRect() reports them
+  std::vector<FBFloat> _boundingX;
+  std::vector<FBFloat> _boundingY;
+  std::vector<FBFloat> _boundingWidth;
+  std::vector<FBFloat> _boundingHeight;
+  std::vector<Index> _edgeContour;
+  std::vector<std::shared_ptr<FBBezierCurve>> _curves;
+
+  // The edges of contour i are [_contourFirstEdge[i], _contourFirstEdge[i + 1])
+  std::vector<Index> _contourFirstEdge;
+  std::vector<FBRect> _contourBoundingRects;
+  std::vector<std::shared_ptr<FBBezierContour>> _contours;
+
+public:
+  FBEdgeTable(const std::vector<std::shared_ptr<FBBezierContour>> &contours);
+
+  Index edgeCount() const { return static_cast<Index>(_curves.size()); }
+  Index contourCount() const { return static_cast<Index>(_contours.size()); }
+
+  Index firstEdgeOfContour(Index contour) const { return _contourFirstEdge[contour]; }
+  Index endEdgeOfContour(Index contour) const { return _contourFirstEdge[contour + 1]; }
+  Index contourOfEdge(Index edge) const { return _edgeContour[edge]; }
+
+  const std::shared_ptr<FBBezierCurve> &curve(Index edge) const { return _curves[edge]; }
+  const std::shared_ptr<FBBezierContour> &contour(Index contour) const { return _contours[contour]; }
+
+  // index is 0 for endPoint1, 1 and 2 for the control points, 3 for endPoint2
+  FBPoint point(Index edge, std::size_t index) const { return FBPoint{_x[index][edge], _y[index][edge]}; }
+  bool isStraightLine(Index edge) const { return _isStraightLine[edge] != 0; }
+
+  FBRect boundingRect(Index edge) const {
+    return FBMakeRect(_boundingX[edge], _boundingY[edge], _boundingWidth[edge], _boundingHeight[edge]);
+  }
+  FBFloat boundingMinX(Index edge) const { return _boundingX[edge]; }
+  FBFloat boundingMaxX(Index edge) const { return _boundingX[edge] + _boundingWidth[edge]; }
+  // The union of the bounding rects of the contour's edges
+  FBRect contourBoundingRect(Index contour) const { return _contourBoundingRects[contour]; }
+
+  // Computes all the lazily cached values of the curves that intersecting them reads, so several
+  //  threads can intersect the curves at the same time without writing to them.
+  void prepareForConcurrentIntersections() const;
+};
+
+} // namespace fb
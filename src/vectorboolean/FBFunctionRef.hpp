@@ -0,0 +1,59 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "FBCommon.hpp"
+
+#include <type_traits>
+#include <utility>
+
+namespace fb {
+
+template <typename Signature> class FBFunctionRef;
+
+// FBFunctionRef is a non-owning reference to a callable, used for the blocks passed to the
+//  intersection and crossing enumeration methods. Unlike std::function it never allocates and
+//  copying it is two pointer copies, so it can be passed down recursive calls for free. It must
+//  not outlive the callable it was made from, which is always true for a block parameter.
+template <typename Result, typename... Arguments> class FBFunctionRef<Result(Arguments...)> {
+  void *_callable = nullptr;
+  Result (*_invoke)(void *callable, Arguments... arguments) = nullptr;
+
+public:
+  template <typename Callable>
+    requires(!std::is_same_v<std::remove_cvref_t<Callable>, FBFunctionRef>
+             && std::is_invocable_r_v<Result, Callable &, Arguments...>)
+  FBFunctionRef(Callable &&callable)
+      : _callable(const_cast<void *>(static_cast<const void *>(std::addressof(callable))))
+      , _invoke([](void *callable, Arguments... arguments) -> Result {
+        return (*static_cast<std::remove_reference_t<Callable> *>(callable))(std::forward<Arguments>(arguments)...);
+      }) {}
+
+  Result operator()(Arguments... arguments) const { return _invoke(_callable, std::forward<Arguments>(arguments)...); }
+};
+
+} // namespace fb
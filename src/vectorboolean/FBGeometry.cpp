@@ -34,6 +34,9 @@ OTHER DEALINGS IN THE SOFTWARE.
 
 #include "FBGeometry.hpp"
 
+#include <cmath>
+#include <limits>
+
 namespace fb {
 
 static const FBFloat FBPointClosenessThreshold = 1e-10;
@@ -59,6 +62,89 @@ FBFloat FBDistancePointToLine(FBPoint point, FBPoint lineStartPoint, FBPoint lin
   return FBDistanceBetweenPoints(point, intersectionPoint);
 }
 
+// Error free transformations: the rounded result, plus the rounding error as a second term
+static void FBTwoSum(FBFloat a, FBFloat b, FBFloat *sum, FBFloat *error) {
+  *sum = a + b;
+  FBFloat bVirtual = *sum - a;
+  FBFloat aVirtual = *sum - bVirtual;
+  *error = (a - aVirtual) + (b - bVirtual);
+}
+
+static void FBTwoDifference(FBFloat a, FBFloat b, FBFloat *difference, FBFloat *error) {
+  *difference = a - b;
+  FBFloat bVirtual = a - *difference;
+  FBFloat aVirtual = *difference + bVirtual;
+  *error = (a - aVirtual) + (bVirtual - b);
+}
+
+static void FBTwoProduct(FBFloat a, FBFloat b, FBFloat *product, FBFloat *error) {
+  *product = a * b;
+  *error = std::fma(a, b, -*product);
+}
+
+FBFloat FBOrientation(FBPoint lineStart, FBPoint lineEnd, FBPoint point) {
+  // This is Shewchuk's orient2d predicate. First compute the determinant in floating point, and
+  //  if it's bigger than the worst case rounding error, its sign is right.
+  FBFloat left = (lineEnd.x - lineStart.x) * (point.y - lineStart.y);
+  FBFloat right = (lineEnd.y - lineStart.y) * (point.x - lineStart.x);
+  FBFloat determinant = left - right;
+  static const FBFloat epsilon = std::numeric_limits<FBFloat>::epsilon() / 2.0;
+  static const FBFloat errorBound = (3.0 + 16.0 * epsilon) * epsilon;
+  if (std::abs(determinant) >= errorBound * (std::abs(left) + std::abs(right))) {
+    return determinant;
+  }
+
+  // Otherwise compute it exactly, as a sum of non-overlapping terms. Each coordinate difference is
+  //  a pair of terms, so each product is four pairs.
+  FBFloat differences[4][2] = {};
+  FBTwoDifference(lineEnd.x, lineStart.x, &differences[0][0], &differences[0][1]);
+  FBTwoDifference(point.y, lineStart.y, &differences[1][0], &differences[1][1]);
+  FBTwoDifference(lineEnd.y, lineStart.y, &differences[2][0], &differences[2][1]);
+  FBTwoDifference(point.x, lineStart.x, &differences[3][0], &differences[3][1]);
+
+  FBFloat expansion[16] = {};
+  size_t expansionLength = 0;
+  auto addTerm = [&](FBFloat term) {
+    for (size_t i = 0; i < expansionLength; i++) {
+      FBTwoSum(term, expansion[i], &term, &expansion[i]);
+    }
+    expansion[expansionLength++] = term;
+  };
+  for (size_t i = 0; i < 2; i++) {
+    for (size_t j = 0; j < 2; j++) {
+      FBFloat product = 0.0, error = 0.0;
+      FBTwoProduct(differences[0][i], differences[1][j], &product, &error);
+      addTerm(product);
+      addTerm(error);
+      FBTwoProduct(-differences[2][i], differences[3][j], &product, &error);
+      addTerm(product);
+      addTerm(error);
+    }
+  }
+
+  // Adding the terms up in floating point could cancel to 0 or flip the sign. Compress the
+  //  expansion instead, as Shewchuk's orient2dadapt does: sum it from the top down, keeping each
+  //  nonzero rounding error as a term, then from the bottom up. The largest term of the result is
+  //  within a rounding error of the determinant and has its exact sign.
+  size_t bottom = expansionLength - 1;
+  FBFloat largest = expansion[bottom];
+  for (size_t i = expansionLength - 1; i-- > 0;) {
+    FBFloat sum = 0.0, error = 0.0;
+    FBTwoSum(largest, expansion[i], &sum, &error);
+    if (error != 0.0) {
+      expansion[bottom--] = sum;
+      largest = error;
+    } else {
+      largest = sum;
+    }
+  }
+  for (size_t i = bottom + 1; i < expansionLength; i++) {
+    FBFloat error = 0.0;
+    FBTwoSum(expansion[i], largest, &largest, &error);
+  }
+  return largest;
+}
+
 FBPoint FBAddPoint(FBPoint point1, FBPoint point2) { return FBMakePoint(point1.x + point2.x, point1.y + point2.y); }
 
 FBPoint FBUnitScalePoint(FBPoint point, FBFloat scale) {
@@ -33,6 +33,10 @@ FBFloat FBDistanceBetweenPoints(FBPoint point1, FBPoint point2);
 FBFloat FBDistancePointToLine(FBPoint point, FBPoint lineStartPoint, FBPoint lineEndPoint);
 FBPoint FBLineNormal(FBPoint lineStart, FBPoint lineEnd);
 FBPoint FBLineMidpoint(FBPoint lineStart, FBPoint lineEnd);
+// Twice the signed area of the triangle (lineStart, lineEnd, point): greater than 0 if the points
+//  make a counter-clockwise turn, less than 0 if clockwise, 0 if they're colinear. The sign is
+//  exact; only the magnitude is rounded.
+FBFloat FBOrientation(FBPoint lineStart, FBPoint lineEnd, FBPoint point);
 
 FBPoint FBAddPoint(FBPoint point1, FBPoint point2);
 FBPoint FBScalePoint(FBPoint point, FBFloat scale);
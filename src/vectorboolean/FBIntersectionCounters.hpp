@@ -0,0 +1,90 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "FBCommon.hpp"
+
+#include <cstddef>
+
+// Set to 0 to compile the counting out of the curve intersection code
+#ifndef FB_INTERSECTION_COUNTERS
+#define FB_INTERSECTION_COUNTERS 1
+#endif
+
+namespace fb {
+
+// FBIntersectionCounters counts the work done by the curve intersection code, to find the inputs
+//  that make it slow. Counting only happens while a FBIntersectionCountersScope is alive.
+struct FBIntersectionCounters {
+  std::size_t pairsTested = 0;            // calls to FBBezierCurve::intersectionsWithBezierCurve()
+  std::size_t boundingRectRejections = 0; // pairs whose bounding boxes don't overlap
+  std::size_t boundsRejections = 0;       // pairs whose tight bounds don't overlap
+  std::size_t clippingIterations = 0;     // iterations of the bezier clipping loop
+  std::size_t subdivisions = 0;           // times a curve was split in half to recurse on
+  std::size_t maxIterationsReached = 0;   // times the clipping loop gave up
+  std::size_t maxDepthReached = 0;        // times a curve needed splitting but was too deep already
+  std::size_t newtonRefinements = 0;      // Newton steps refining a parameter
+  std::size_t overlapRanges = 0;          // overlapping sections of curves found
+
+  FBIntersectionCounters &operator+=(const FBIntersectionCounters &other);
+
+  // The counters of the calling thread's current scope, or nullptr if there isn't one
+  static FBIntersectionCounters *current() { return _current; }
+
+private:
+  friend class FBIntersectionCountersScope;
+  static inline thread_local FBIntersectionCounters *_current = nullptr;
+};
+
+// Creating a FBIntersectionCountersScope makes counters the current counters of the calling thread
+//  until it's destroyed; the counters that were current before are restored then. A nullptr
+//  counters stops the counting. FBParallelFor counts the work of its threads separately and adds
+//  it to the calling thread's counters when they're done, so the counts don't depend on the number
+//  of threads.
+class FBIntersectionCountersScope {
+  FBIntersectionCounters *_previous;
+
+public:
+  explicit FBIntersectionCountersScope(FBIntersectionCounters *counters)
+      : _previous(FBIntersectionCounters::_current) {
+    FBIntersectionCounters::_current = counters;
+  }
+  ~FBIntersectionCountersScope() { FBIntersectionCounters::_current = _previous; }
+  FBIntersectionCountersScope(const FBIntersectionCountersScope &) = delete;
+  FBIntersectionCountersScope &operator=(const FBIntersectionCountersScope &) = delete;
+};
+
+// Adds one to a counter of the current counters, if there are any
+inline void FBCountIntersectionWork(std::size_t FBIntersectionCounters::*counter) {
+#if FB_INTERSECTION_COUNTERS
+  if (auto counters = FBIntersectionCounters::current()) {
+    (counters->*counter)++;
+  }
+#endif
+}
+
+} // namespace fb
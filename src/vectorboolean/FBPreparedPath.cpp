@@ -0,0 +1,154 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FBPreparedPath.hpp"
+#include "FBArena.hpp"
+#include "FBBezierGraph.hpp"
+#include "FBBooleanStats.hpp"
+
+namespace fb {
+
+FBPreparedPath::FBPreparedPath(const FBBezierPath &path) : _graph(FBMakeShared<FBBezierGraph>(path)) {
+  _graph->prepare();
+}
+
+FBRect FBPreparedPath::bounds() const { return _graph->bounds(); }
+
+std::shared_ptr<FBBezierGraph> FBPreparedPath::graph() const { return _graph->clone(); }
+
+FBBezierPath FBPreparedPath::unionWithPath(const FBBezierPath &path, FBBooleanStats *stats) const {
+  FBOperationArena arena; // the graphs are allocated from, and released with, this arena
+  std::shared_ptr<FBBezierGraph> graph1;
+  std::shared_ptr<FBBezierGraph> graph2;
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::buildGraphs, "buildGraphs");
+    graph1 = graph();
+    graph2 = FBMakeShared<fb::FBBezierGraph>(path);
+  }
+  auto resultGraph = graph1->unionWithBezierGraph(graph2, stats);
+  FBBooleanStatsTimer timer(stats, &FBBooleanStats::bezierPath, "bezierPath");
+  return resultGraph->bezierPath();
+}
+
+FBBezierPath FBPreparedPath::intersectWithPath(const FBBezierPath &path, FBBooleanStats *stats) const {
+  FBOperationArena arena; // the graphs are allocated from, and released with, this arena
+  std::shared_ptr<FBBezierGraph> graph1;
+  std::shared_ptr<FBBezierGraph> graph2;
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::buildGraphs, "buildGraphs");
+    graph1 = graph();
+    graph2 = FBMakeShared<fb::FBBezierGraph>(path);
+  }
+  auto resultGraph = graph1->intersectWithBezierGraph(graph2, stats);
+  FBBooleanStatsTimer timer(stats, &FBBooleanStats::bezierPath, "bezierPath");
+  return resultGraph->bezierPath();
+}
+
+FBBezierPath FBPreparedPath::differenceWithPath(const FBBezierPath &path, FBBooleanStats *stats) const {
+  FBOperationArena arena; // the graphs are allocated from, and released with, this arena
+  std::shared_ptr<FBBezierGraph> graph1;
+  std::shared_ptr<FBBezierGraph> graph2;
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::buildGraphs, "buildGraphs");
+    graph1 = graph();
+    graph2 = FBMakeShared<fb::FBBezierGraph>(path);
+  }
+  auto resultGraph = graph1->differenceWithBezierGraph(graph2, stats);
+  FBBooleanStatsTimer timer(stats, &FBBooleanStats::bezierPath, "bezierPath");
+  return resultGraph->bezierPath();
+}
+
+FBBezierPath FBPreparedPath::xorWithPath(const FBBezierPath &path, FBBooleanStats *stats) const {
+  FBOperationArena arena; // the graphs are allocated from, and released with, this arena
+  std::shared_ptr<FBBezierGraph> graph1;
+  std::shared_ptr<FBBezierGraph> graph2;
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::buildGraphs, "buildGraphs");
+    graph1 = graph();
+    graph2 = FBMakeShared<fb::FBBezierGraph>(path);
+  }
+  auto resultGraph = graph1->xorWithBezierGraph(graph2, stats);
+  FBBooleanStatsTimer timer(stats, &FBBooleanStats::bezierPath, "bezierPath");
+  return resultGraph->bezierPath();
+}
+
+FBBezierPath FBPreparedPath::unionWithPath(const FBPreparedPath &path, FBBooleanStats *stats) const {
+  FBOperationArena arena; // the graphs are allocated from, and released with, this arena
+  std::shared_ptr<FBBezierGraph> graph1;
+  std::shared_ptr<FBBezierGraph> graph2;
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::buildGraphs, "buildGraphs");
+    graph1 = graph();
+    graph2 = path.graph();
+  }
+  auto resultGraph = graph1->unionWithBezierGraph(graph2, stats);
+  FBBooleanStatsTimer timer(stats, &FBBooleanStats::bezierPath, "bezierPath");
+  return resultGraph->bezierPath();
+}
+
+FBBezierPath FBPreparedPath::intersectWithPath(const FBPreparedPath &path, FBBooleanStats *stats) const {
+  FBOperationArena arena; // the graphs are allocated from, and released with, this arena
+  std::shared_ptr<FBBezierGraph> graph1;
+  std::shared_ptr<FBBezierGraph> graph2;
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::buildGraphs, "buildGraphs");
+    graph1 = graph();
+    graph2 = path.graph();
+  }
+  auto resultGraph = graph1->intersectWithBezierGraph(graph2, stats);
+  FBBooleanStatsTimer timer(stats, &FBBooleanStats::bezierPath, "bezierPath");
+  return resultGraph->bezierPath();
+}
+
+FBBezierPath FBPreparedPath::differenceWithPath(const FBPreparedPath &path, FBBooleanStats *stats) const {
+  FBOperationArena arena; // the graphs are allocated from, and released with, this arena
+  std::shared_ptr<FBBezierGraph> graph1;
+  std::shared_ptr<FBBezierGraph> graph2;
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::buildGraphs, "buildGraphs");
+    graph1 = graph();
+    graph2 = path.graph();
+  }
+  auto resultGraph = graph1->differenceWithBezierGraph(graph2, stats);
+  FBBooleanStatsTimer timer(stats, &FBBooleanStats::bezierPath, "bezierPath");
+  return resultGraph->bezierPath();
+}
+
+FBBezierPath FBPreparedPath::xorWithPath(const FBPreparedPath &path, FBBooleanStats *stats) const {
+  FBOperationArena arena; // the graphs are allocated from, and released with, this arena
+  std::shared_ptr<FBBezierGraph> graph1;
+  std::shared_ptr<FBBezierGraph> graph2;
+  {
+    FBBooleanStatsTimer timer(stats, &FBBooleanStats::buildGraphs, "buildGraphs");
+    graph1 = graph();
+    graph2 = path.graph();
+  }
+  auto resultGraph = graph1->xorWithBezierGraph(graph2, stats);
+  FBBooleanStatsTimer timer(stats, &FBBooleanStats::bezierPath, "bezierPath");
+  return resultGraph->bezierPath();
+}
+
+} // namespace fb
@@ -0,0 +1,65 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "FBCommon.hpp"
+#include "FBBezierPath.hpp"
+
+namespace fb {
+
+class FBBezierGraph;
+struct FBBooleanStats;
+
+// FBPreparedPath is a path converted to a bezier graph once, with everything that only depends
+//  on the path itself computed up front: curve and contour bounds, the hole or filled
+//  classification of the contours and a spatial index of the edges (see
+//  FBBezierGraph::prepare()). It's meant for a path used in many boolean operations, like a
+//  mask that thousands of shapes are clipped against. It can be either operand of any
+//  operation; each operation works on its own copy of the graph, so a prepared path is never
+//  modified and can be shared between threads.
+class FBPreparedPath {
+  std::shared_ptr<FBBezierGraph> _graph;
+
+public:
+  explicit FBPreparedPath(const FBBezierPath &path);
+
+  FBRect bounds() const;
+  // A copy of the prepared graph for a boolean operation to modify
+  std::shared_ptr<FBBezierGraph> graph() const;
+
+  FBBezierPath unionWithPath(const FBBezierPath &path, FBBooleanStats *stats = nullptr) const;
+  FBBezierPath intersectWithPath(const FBBezierPath &path, FBBooleanStats *stats = nullptr) const;
+  FBBezierPath differenceWithPath(const FBBezierPath &path, FBBooleanStats *stats = nullptr) const;
+  FBBezierPath xorWithPath(const FBBezierPath &path, FBBooleanStats *stats = nullptr) const;
+
+  FBBezierPath unionWithPath(const FBPreparedPath &path, FBBooleanStats *stats = nullptr) const;
+  FBBezierPath intersectWithPath(const FBPreparedPath &path, FBBooleanStats *stats = nullptr) const;
+  FBBezierPath differenceWithPath(const FBPreparedPath &path, FBBooleanStats *stats = nullptr) const;
+  FBBezierPath xorWithPath(const FBPreparedPath &path, FBBooleanStats *stats = nullptr) const;
+};
+
+} // namespace fb
@@ -0,0 +1,445 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FBRectilinear.hpp"
+#include "FBBezierIntersection.hpp"
+#include "FBGeometry.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <memory_resource>
+#include <tuple>
+#include <vector>
+
+namespace fb {
+
+// Polygons with more edges than this are left to the general code, since checking that a polygon
+//  doesn't cross itself compares every pair of its edges.
+static const std::size_t FBRectilinearMaximumEdgeCount = 64;
+
+struct FBRectilinearCrossing {
+  FBPoint location;
+  FBFloat parameter = 0.0;  // how far along its edge the crossing is, from 0 at the start to 1 at the end
+  uint32_t edge = 0;        // index of the edge the crossing is on
+  uint32_t counterpart = 0; // index of the same crossing among the other polygon's crossings
+  bool isEntry = false;
+  bool isProcessed = false;
+};
+
+// Edge i runs from vertices[i] to vertices[i + 1], and the last edge back to vertices[0], which
+//  are the edges FBBezierGraph would make from the same path.
+struct FBRectilinearPolygon {
+  std::pmr::vector<FBPoint> vertices;
+  std::pmr::vector<FBRectilinearCrossing> crossings; // ordered by edge, then by parameter
+  std::pmr::vector<uint32_t> firstCrossings; // the crossings on edge i are [firstCrossings[i], firstCrossings[i + 1])
+  bool isCounterClockwise = false;
+
+  explicit FBRectilinearPolygon(std::pmr::memory_resource *resource)
+      : vertices(resource)
+      , crossings(resource)
+      , firstCrossings(resource) {}
+
+  uint32_t edgeCount() const { return static_cast<uint32_t>(vertices.size()); }
+  uint32_t nextEdge(uint32_t edge) const { return edge + 1 < edgeCount() ? edge + 1 : 0; }
+  uint32_t previousEdge(uint32_t edge) const { return edge > 0 ? edge - 1 : edgeCount() - 1; }
+  FBPoint startOfEdge(uint32_t edge) const { return vertices[edge]; }
+  FBPoint endOfEdge(uint32_t edge) const { return vertices[nextEdge(edge)]; }
+  FBPoint direction(uint32_t edge) const {
+    return FBPoint{endOfEdge(edge).x - startOfEdge(edge).x, endOfEdge(edge).y - startOfEdge(edge).y};
+  }
+  bool isHorizontal(uint32_t edge) const { return startOfEdge(edge).y == endOfEdge(edge).y; }
+  bool hasCrossings(uint32_t edge) const { return firstCrossings[edge] != firstCrossings[edge + 1]; }
+};
+
+// Whether the ranges [minimum1, maximum1] and [minimum2, maximum2] overlap, or come close enough
+//  that the general code could find them touching.
+static bool FBRangesTouch(FBFloat minimum1, FBFloat maximum1, FBFloat minimum2, FBFloat maximum2) {
+  return (maximum1 >= minimum2 || FBAreValuesClose(maximum1, minimum2))
+         && (maximum2 >= minimum1 || FBAreValuesClose(maximum2, minimum1));
+}
+
+static bool FBRectilinearEdgesTouch(const FBRectilinearPolygon &polygon1, uint32_t edge1,
+                                    const FBRectilinearPolygon &polygon2, uint32_t edge2) {
+  auto start1 = polygon1.startOfEdge(edge1);
+  auto end1 = polygon1.endOfEdge(edge1);
+  auto start2 = polygon2.startOfEdge(edge2);
+  auto end2 = polygon2.endOfEdge(edge2);
+  return FBRangesTouch(std::min(start1.x, end1.x), std::max(start1.x, end1.x), std::min(start2.x, end2.x),
+                       std::max(start2.x, end2.x))
+         && FBRangesTouch(std::min(start1.y, end1.y), std::max(start1.y, end1.y), std::min(start2.y, end2.y),
+                          std::max(start2.y, end2.y));
+}
+
+// Reads path into polygon, returning false if it isn't a single, simple contour of horizontal and
+//  vertical lines.
+static bool FBReadRectilinearPolygon(const FBBezierPath &path, FBRectilinearPolygon &polygon) {
+  if (path.size() < 2 || path.size() > FBRectilinearMaximumEdgeCount + 2
+      || path[0].type != FBBezierPath::Type::move) {
+    return false;
+  }
+
+  // Skip degenerate lines, like FBBezierGraph does
+  auto &vertices = polygon.vertices;
+  vertices.reserve(path.size());
+  vertices.push_back(path[0].points[0]);
+  bool isClosed = false;
+  for (std::size_t i = 1; i < path.size(); i++) {
+    const auto &element = path[i];
+    if (element.type == FBBezierPath::Type::close && i == path.size() - 1) {
+      isClosed = true;
+    } else if (element.type != FBBezierPath::Type::line) {
+      return false;
+    } else if (!FBEqualPoints(element.points[0], vertices.back())) {
+      vertices.push_back(element.points[0]);
+    }
+  }
+
+  // The contour is closed with a line back to the start, unless it's already there. A contour that
+  //  isn't closed explicitly is also left as is when it ends just close to its start, which leaves a
+  //  gap this code doesn't model.
+  if (FBEqualPoints(vertices.back(), vertices.front())) {
+    vertices.pop_back();
+  } else if (!isClosed && FBArePointsClose(vertices.back(), vertices.front())) {
+    return false;
+  }
+  if (vertices.size() < 4) {
+    return false;
+  }
+
+  FBFloat area = 0.0;
+  for (uint32_t edge = 0; edge < polygon.edgeCount(); edge++) {
+    auto start = polygon.startOfEdge(edge);
+    auto end = polygon.endOfEdge(edge);
+    if (!std::isfinite(start.x) || !std::isfinite(start.y) || (start.x != end.x && start.y != end.y)) {
+      return false;
+    }
+    area += start.x * end.y - end.x * start.y;
+  }
+  if (area == 0.0) {
+    return false;
+  }
+  polygon.isCounterClockwise = area > 0.0;
+
+  // Neighbouring edges only share their common end point unless they double back on each other, and
+  //  edges further apart mustn't touch at all. Four horizontal and vertical edges that close up
+  //  around some area always make a rectangle, so the common case needs no checking.
+  if (polygon.edgeCount() == 4) {
+    return true;
+  }
+  for (uint32_t edge1 = 0; edge1 < polygon.edgeCount(); edge1++) {
+    for (uint32_t edge2 = edge1 + 1; edge2 < polygon.edgeCount(); edge2++) {
+      if (edge2 == edge1 + 1 || (edge1 == 0 && edge2 == polygon.edgeCount() - 1)) {
+        if (polygon.isHorizontal(edge1) == polygon.isHorizontal(edge2)
+            && FBDotMultiplyPoint(polygon.direction(edge1), polygon.direction(edge2)) < 0.0) {
+          return false;
+        }
+      } else if (FBRectilinearEdgesTouch(polygon, edge1, polygon, edge2)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Where along edge the given point, which is on the edge's line, is
+static FBFloat FBRectilinearParameter(const FBRectilinearPolygon &polygon, uint32_t edge, FBPoint point) {
+  auto start = polygon.startOfEdge(edge);
+  auto end = polygon.endOfEdge(edge);
+  if (polygon.isHorizontal(edge)) {
+    return (point.x - start.x) / (end.x - start.x);
+  }
+  return (point.y - start.y) / (end.y - start.y);
+}
+
+static bool FBIsParameterInsideEdge(FBFloat parameter) {
+  return parameter > FBParameterCloseThreshold && parameter < 1.0 - FBParameterCloseThreshold;
+}
+
+// Whether walking forward along edge1 of polygon1 through a crossing with edge2 of polygon2 goes
+//  into polygon2
+static bool FBIsEnteringPolygon(const FBRectilinearPolygon &polygon1, uint32_t edge1,
+                                const FBRectilinearPolygon &polygon2, uint32_t edge2) {
+  auto direction1 = polygon1.direction(edge1);
+  auto direction2 = polygon2.direction(edge2);
+  // The inside of a counter-clockwise polygon is to the left of its edges
+  bool isToTheLeft = direction2.x * direction1.y - direction2.y * direction1.x > 0.0;
+  return isToTheLeft == polygon2.isCounterClockwise;
+}
+
+// Sorts the crossings of polygon by edge and parameter. Each crossing's counterpart has to be its
+//  own index beforehand; returns where each of the crossings, by that index, ended up.
+static std::pmr::vector<uint32_t> FBSortRectilinearCrossings(FBRectilinearPolygon &polygon) {
+  auto &crossings = polygon.crossings;
+  std::sort(crossings.begin(), crossings.end(), [](const auto &crossing1, const auto &crossing2) {
+    return std::tie(crossing1.edge, crossing1.parameter) < std::tie(crossing2.edge, crossing2.parameter);
+  });
+  std::pmr::vector<uint32_t> positions(crossings.size(), crossings.get_allocator().resource());
+  for (uint32_t position = 0; position < crossings.size(); position++) {
+    positions[crossings[position].counterpart] = position;
+  }
+
+  polygon.firstCrossings.assign(polygon.edgeCount() + 1, 0);
+  for (const auto &crossing : crossings) {
+    polygon.firstCrossings[crossing.edge + 1]++;
+  }
+  for (uint32_t edge = 0; edge < polygon.edgeCount(); edge++) {
+    polygon.firstCrossings[edge + 1] += polygon.firstCrossings[edge];
+  }
+  return positions;
+}
+
+// Finds where the edges of the polygons cross, returning false if the polygons aren't in general
+//  position.
+static bool FBInsertRectilinearCrossings(FBRectilinearPolygon &polygon1, FBRectilinearPolygon &polygon2) {
+  for (uint32_t edge1 = 0; edge1 < polygon1.edgeCount(); edge1++) {
+    for (uint32_t edge2 = 0; edge2 < polygon2.edgeCount(); edge2++) {
+      if (!FBRectilinearEdgesTouch(polygon1, edge1, polygon2, edge2)) {
+        continue;
+      }
+      // Touching parallel edges overlap, or at least come close to it
+      bool isHorizontal1 = polygon1.isHorizontal(edge1);
+      if (isHorizontal1 == polygon2.isHorizontal(edge2)) {
+        return false;
+      }
+
+      FBPoint location = isHorizontal1 ? FBPoint{polygon2.startOfEdge(edge2).x, polygon1.startOfEdge(edge1).y}
+                                       : FBPoint{polygon1.startOfEdge(edge1).x, polygon2.startOfEdge(edge2).y};
+      auto parameter1 = FBRectilinearParameter(polygon1, edge1, location);
+      auto parameter2 = FBRectilinearParameter(polygon2, edge2, location);
+      if (!FBIsParameterInsideEdge(parameter1) || !FBIsParameterInsideEdge(parameter2)) {
+        return false;
+      }
+
+      auto index = static_cast<uint32_t>(polygon1.crossings.size());
+      polygon1.crossings.push_back(
+          {.location = location, .parameter = parameter1, .edge = edge1, .counterpart = index});
+      polygon2.crossings.push_back(
+          {.location = location, .parameter = parameter2, .edge = edge2, .counterpart = index});
+    }
+  }
+
+  // Both lists were built in the same order, so until they're sorted each crossing's counterpart
+  //  has the same index as the crossing itself.
+  auto positions1 = FBSortRectilinearCrossings(polygon1);
+  auto positions2 = FBSortRectilinearCrossings(polygon2);
+  for (auto &crossing : polygon1.crossings) {
+    crossing.counterpart = positions2[crossing.counterpart];
+  }
+  for (auto &crossing : polygon2.crossings) {
+    crossing.counterpart = positions1[crossing.counterpart];
+  }
+  return true;
+}
+
+// The rectilinear version of FBBezierContour::markCrossingsAsEntryOrExitWithContour(). Since the
+//  crossings are all proper, a crossing is an entry exactly when going forward through it enters
+//  (if markInside) or leaves (otherwise) the other polygon.
+static void FBMarkRectilinearCrossings(FBRectilinearPolygon &polygon, const FBRectilinearPolygon &otherPolygon,
+                                       bool markInside) {
+  for (auto &crossing : polygon.crossings) {
+    auto otherEdge = otherPolygon.crossings[crossing.counterpart].edge;
+    crossing.isEntry = FBIsEnteringPolygon(polygon, crossing.edge, otherPolygon, otherEdge) == markInside;
+    crossing.isProcessed = false;
+  }
+}
+
+// The rectilinear version of FBBezierGraph::bezierGraphFromIntersections(), appending the contours
+//  to result.
+static void FBWalkRectilinearCrossings(FBRectilinearPolygon &polygon1, FBRectilinearPolygon &polygon2,
+                                       FBBezierPath &result) {
+  FBRectilinearPolygon *polygons[] = {&polygon1, &polygon2};
+  for (uint32_t first = 0; first < polygon1.crossings.size(); first++) {
+    if (polygon1.crossings[first].isProcessed) {
+      continue;
+    }
+
+    std::size_t side = 0;
+    uint32_t index = first;
+    result.moveTo(polygon1.crossings[first].location);
+    while (!polygons[side]->crossings[index].isProcessed) {
+      auto &polygon = *polygons[side];
+      auto &crossing = polygon.crossings[index];
+      crossing.isProcessed = true;
+
+      auto edge = crossing.edge;
+      if (crossing.isEntry) {
+        if (index + 1 < polygon.firstCrossings[edge + 1]) {
+          index++;
+        } else {
+          // Output the rest of the edge, and whole edges until one with a crossing
+          edge = polygon.nextEdge(edge);
+          result.lineTo(polygon.startOfEdge(edge));
+          while (!polygon.hasCrossings(edge)) {
+            edge = polygon.nextEdge(edge);
+            result.lineTo(polygon.startOfEdge(edge));
+          }
+          index = polygon.firstCrossings[edge];
+        }
+      } else {
+        if (index > polygon.firstCrossings[edge]) {
+          index--;
+        } else {
+          result.lineTo(polygon.startOfEdge(edge));
+          edge = polygon.previousEdge(edge);
+          while (!polygon.hasCrossings(edge)) {
+            result.lineTo(polygon.startOfEdge(edge));
+            edge = polygon.previousEdge(edge);
+          }
+          index = polygon.firstCrossings[edge + 1] - 1;
+        }
+      }
+      result.lineTo(polygon.crossings[index].location);
+
+      // Switch over to the counterpart in the other polygon
+      polygon.crossings[index].isProcessed = true;
+      index = polygon.crossings[index].counterpart;
+      side = 1 - side;
+    }
+    result.close();
+  }
+}
+
+// Even-odd containment, as FBBezierContour::containsPoint() decides it, for a point that isn't on
+//  the polygon's outline
+static bool FBRectilinearPolygonContainsPoint(const FBRectilinearPolygon &polygon, FBPoint point) {
+  bool contains = false;
+  for (uint32_t edge = 0; edge < polygon.edgeCount(); edge++) {
+    auto start = polygon.startOfEdge(edge);
+    auto end = polygon.endOfEdge(edge);
+    if (start.x > point.x && start.x == end.x && (start.y <= point.y) != (end.y <= point.y)) {
+      contains = !contains;
+    }
+  }
+  return contains;
+}
+
+static void FBAppendRectilinearPolygon(const FBRectilinearPolygon &polygon, FBBezierPath &result) {
+  result.moveTo(polygon.vertices[0]);
+  for (uint32_t edge = 0; edge < polygon.edgeCount(); edge++) {
+    result.lineTo(polygon.endOfEdge(edge));
+  }
+  result.close();
+}
+
+// Mirrors the way the FBBezierGraph operations handle contours that don't cross anything, for
+//  polygons that don't cross each other. Neither can be the other's equivalent, so each one is
+//  either disjoint from the other or contained by it.
+static void FBAppendNoncrossingRectilinearPolygons(const FBRectilinearPolygon &polygon1,
+                                                   const FBRectilinearPolygon &polygon2,
+                                                   FBBooleanOperation operation, FBBezierPath &result) {
+  bool polygon2ContainsPolygon1 = FBRectilinearPolygonContainsPoint(polygon2, polygon1.vertices[0]);
+  bool polygon1ContainsPolygon2 = FBRectilinearPolygonContainsPoint(polygon1, polygon2.vertices[0]);
+  switch (operation) {
+  case FBBooleanOperation::unite:
+    if (!polygon2ContainsPolygon1) {
+      FBAppendRectilinearPolygon(polygon1, result);
+    }
+    if (!polygon1ContainsPolygon2) {
+      FBAppendRectilinearPolygon(polygon2, result);
+    }
+    break;
+  case FBBooleanOperation::intersect:
+    if (polygon2ContainsPolygon1) {
+      FBAppendRectilinearPolygon(polygon1, result);
+    }
+    if (polygon1ContainsPolygon2) {
+      FBAppendRectilinearPolygon(polygon2, result);
+    }
+    break;
+  case FBBooleanOperation::subtract:
+    if (!polygon2ContainsPolygon1) {
+      FBAppendRectilinearPolygon(polygon1, result);
+    }
+    if (polygon1ContainsPolygon2) {
+      FBAppendRectilinearPolygon(polygon2, result);
+    }
+    break;
+  case FBBooleanOperation::exclusiveOr:
+    FBAppendNoncrossingRectilinearPolygons(polygon1, polygon2, FBBooleanOperation::unite, result);
+    FBAppendNoncrossingRectilinearPolygons(polygon1, polygon2, FBBooleanOperation::intersect, result);
+    break;
+  }
+}
+
+bool FBRectilinearBooleanOperation(const FBBezierPath &path1, const FBBezierPath &path2,
+                                   FBBooleanOperation operation, FBBezierPath &result) {
+  // The polygons are small, so their storage comes from the stack unless they're unusually
+  //  complicated
+  std::array<std::byte, 8 * 1024> buffer;
+  std::pmr::monotonic_buffer_resource resource(buffer.data(), buffer.size());
+  FBRectilinearPolygon polygon1(&resource);
+  FBRectilinearPolygon polygon2(&resource);
+  if (!FBReadRectilinearPolygon(path1, polygon1) || !FBReadRectilinearPolygon(path2, polygon2)
+      || !FBInsertRectilinearCrossings(polygon1, polygon2)) {
+    return false;
+  }
+
+  // Every vertex and crossing ends up in each walk over the crossings at most once, and each contour
+  //  adds a move to and a close
+  FBBezierPath path;
+  auto crossingCount = polygon1.crossings.size();
+  auto walkSize = polygon1.edgeCount() + polygon2.edgeCount() + 3 * crossingCount + 2;
+  path.reserve(operation == FBBooleanOperation::exclusiveOr ? 2 * walkSize : walkSize);
+  if (crossingCount == 0) {
+    FBAppendNoncrossingRectilinearPolygons(polygon1, polygon2, operation, path);
+    result = std::move(path);
+    return true;
+  }
+
+  // The union and intersection parts of an exclusive or only share edges, so subtracting the
+  //  intersection from the union, as FBBezierGraph does, leaves both of them as they are.
+  switch (operation) {
+  case FBBooleanOperation::unite:
+    FBMarkRectilinearCrossings(polygon1, polygon2, false);
+    FBMarkRectilinearCrossings(polygon2, polygon1, false);
+    FBWalkRectilinearCrossings(polygon1, polygon2, path);
+    break;
+  case FBBooleanOperation::intersect:
+    FBMarkRectilinearCrossings(polygon1, polygon2, true);
+    FBMarkRectilinearCrossings(polygon2, polygon1, true);
+    FBWalkRectilinearCrossings(polygon1, polygon2, path);
+    break;
+  case FBBooleanOperation::subtract:
+    FBMarkRectilinearCrossings(polygon1, polygon2, false);
+    FBMarkRectilinearCrossings(polygon2, polygon1, true);
+    FBWalkRectilinearCrossings(polygon1, polygon2, path);
+    break;
+  case FBBooleanOperation::exclusiveOr:
+    FBMarkRectilinearCrossings(polygon1, polygon2, false);
+    FBMarkRectilinearCrossings(polygon2, polygon1, false);
+    FBWalkRectilinearCrossings(polygon1, polygon2, path);
+    FBMarkRectilinearCrossings(polygon1, polygon2, true);
+    FBMarkRectilinearCrossings(polygon2, polygon1, true);
+    FBWalkRectilinearCrossings(polygon1, polygon2, path);
+    break;
+  }
+  result = std::move(path);
+  return true;
+}
+
+} // namespace fb
@@ -0,0 +1,51 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "FBCommon.hpp"
+#include "FBBezierPath.hpp"
+
+namespace fb {
+
+enum class FBBooleanOperation { unite, intersect, subtract, exclusiveOr };
+
+// Boolean operations between rectilinear polygons, i.e. paths made up of a single closed contour
+//  of horizontal and vertical lines, like the ones FBBezierPath::rect() makes. Where two such
+//  polygons cross, a horizontal edge of one meets a vertical edge of the other, so the crossings
+//  can be found exactly without converting the edges to bezier curves or clipping them. The
+//  crossings are then walked the same way FBBezierGraph walks its crossings, so the resulting
+//  contours are the ones the general code would produce, in the same order and starting at the
+//  same points, only without its rounding.
+//
+// This only handles polygons that don't cross themselves and that are in general position: no
+//  edges of the two polygons overlap or touch and no crossing is close to the end of an edge. It
+//  returns false, leaving result alone, for anything else, and the caller falls back on the
+//  general code.
+bool FBRectilinearBooleanOperation(const FBBezierPath &path1, const FBBezierPath &path2,
+                                   FBBooleanOperation operation, FBBezierPath &result);
+
+} // namespace fb
@@ -0,0 +1,106 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FBTrace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+
+namespace fb {
+
+static std::atomic<FBTraceSink *> FBConfiguredTraceSink{nullptr};
+
+void FBSetTraceSink(FBTraceSink *sink) { FBConfiguredTraceSink.store(sink); }
+
+FBTraceSink *FBCurrentTraceSink() { return FBConfiguredTraceSink.load(std::memory_order_relaxed); }
+
+// Quotes a string for JSON
+static std::string FBJSONString(std::string_view string) {
+  std::string result = "\"";
+  for (char character : string) {
+    switch (character) {
+    case '"':
+      result += "\\\"";
+      break;
+    case '\\':
+      result += "\\\\";
+      break;
+    case '\n':
+      result += "\\n";
+      break;
+    default:
+      if (static_cast<unsigned char>(character) < 0x20) {
+        result += std::format("\\u{:04x}", static_cast<int>(character));
+      } else {
+        result += character;
+      }
+      break;
+    }
+  }
+  result += '"';
+  return result;
+}
+
+FBChromeTraceWriter::FBChromeTraceWriter(std::chrono::steady_clock::duration leafThreshold)
+    : FBTraceSink(leafThreshold)
+    , _origin(std::chrono::steady_clock::now()) {}
+
+void FBChromeTraceWriter::span(const char *name, std::string_view detail, std::chrono::steady_clock::time_point start,
+                               std::chrono::steady_clock::duration duration) {
+  using Microseconds = std::chrono::duration<double, std::micro>;
+  auto timestamp = std::chrono::duration_cast<Microseconds>(start - _origin).count();
+  auto length = std::chrono::duration_cast<Microseconds>(duration).count();
+
+  std::lock_guard lock(_mutex);
+  auto thread = std::find(_threads.begin(), _threads.end(), std::this_thread::get_id());
+  if (thread == _threads.end()) {
+    thread = _threads.insert(_threads.end(), std::this_thread::get_id());
+  }
+  if (!_events.empty()) {
+    _events += ",\n";
+  }
+  _events += std::format(R"(  {{"name": {}, "cat": "vectorboolean", "ph": "X", "ts": {:.3f}, "dur": {:.3f}, )"
+                         R"("pid": 1, "tid": {})",
+                         FBJSONString(name), timestamp, length, thread - _threads.begin());
+  if (!detail.empty()) {
+    _events += std::format(R"(, "args": {{"detail": {}}})", FBJSONString(detail));
+  }
+  _events += "}";
+}
+
+std::string FBChromeTraceWriter::toJSON() const {
+  std::lock_guard lock(_mutex);
+  return std::format("{{\"traceEvents\": [\n{}\n], \"displayTimeUnit\": \"ms\"}}\n", _events);
+}
+
+void FBChromeTraceWriter::writeJSON(const std::string &filename) const {
+  std::ofstream of(filename, std::ios::out);
+  of << toJSON();
+  of.close();
+}
+
+} // namespace fb
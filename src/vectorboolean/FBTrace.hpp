@@ -0,0 +1,155 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "FBCommon.hpp"
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Set to 0 to compile the tracing out of the boolean operations
+#ifndef FB_TRACING
+#define FB_TRACING 1
+#endif
+
+namespace fb {
+
+// FBTraceSink receives the spans of work traced by the boolean operations: their phases, and the
+//  leaf calls (containment queries, classifying contours, intersecting a pair of curves) that took
+//  at least leafThreshold(). span() is called from whichever thread ran the work, possibly from
+//  several threads at once, when the work ends.
+class FBTraceSink {
+  std::chrono::steady_clock::duration _leafThreshold;
+
+public:
+  explicit FBTraceSink(std::chrono::steady_clock::duration leafThreshold = std::chrono::microseconds(100))
+      : _leafThreshold(leafThreshold) {}
+  virtual ~FBTraceSink() = default;
+
+  std::chrono::steady_clock::duration leafThreshold() const { return _leafThreshold; }
+  virtual void span(const char *name, std::string_view detail, std::chrono::steady_clock::time_point start,
+                    std::chrono::steady_clock::duration duration) = 0;
+};
+
+// The sink the boolean operations on all threads trace to. The default of nullptr turns tracing
+//  off. The sink must outlive the operations traced to it.
+void FBSetTraceSink(FBTraceSink *sink);
+FBTraceSink *FBCurrentTraceSink();
+
+// FBChromeTraceWriter collects the spans in the Chrome JSON trace event format, which
+//  chrome://tracing and Perfetto open.
+class FBChromeTraceWriter : public FBTraceSink {
+  mutable std::mutex _mutex;
+  std::chrono::steady_clock::time_point _origin;
+  std::vector<std::thread::id> _threads; // the index of a thread is its tid in the trace
+  std::string _events;
+
+public:
+  explicit FBChromeTraceWriter(std::chrono::steady_clock::duration leafThreshold = std::chrono::microseconds(100));
+
+  void span(const char *name, std::string_view detail, std::chrono::steady_clock::time_point start,
+            std::chrono::steady_clock::duration duration) override;
+
+  std::string toJSON() const;
+  void writeJSON(const std::string &filename) const;
+};
+
+#if FB_TRACING
+
+// Traces the work done from its construction to its destruction as a phase, if there's a sink
+class FBTraceSpan {
+  const char *_name;
+  FBTraceSink *_sink;
+  std::chrono::steady_clock::time_point _start;
+
+public:
+  explicit FBTraceSpan(const char *name)
+      : _name(name)
+      , _sink(FBCurrentTraceSink()) {
+    if (_sink != nullptr) {
+      _start = std::chrono::steady_clock::now();
+    }
+  }
+  ~FBTraceSpan() {
+    if (_sink != nullptr) {
+      _sink->span(_name, {}, _start, std::chrono::steady_clock::now() - _start);
+    }
+  }
+  FBTraceSpan(const FBTraceSpan &) = delete;
+  FBTraceSpan &operator=(const FBTraceSpan &) = delete;
+};
+
+// Traces the work done from its construction to its destruction as a leaf call, if there's a sink
+//  and it took at least the sink's leafThreshold(). detail is only called for the leaves traced,
+//  and returns a description of what the call worked on.
+template <typename Detail> class FBTraceLeafSpan {
+  const char *_name;
+  FBTraceSink *_sink;
+  Detail _detail;
+  std::chrono::steady_clock::time_point _start;
+
+public:
+  FBTraceLeafSpan(const char *name, Detail detail)
+      : _name(name)
+      , _sink(FBCurrentTraceSink())
+      , _detail(std::move(detail)) {
+    if (_sink != nullptr) {
+      _start = std::chrono::steady_clock::now();
+    }
+  }
+  ~FBTraceLeafSpan() {
+    if (_sink == nullptr) {
+      return;
+    }
+    auto duration = std::chrono::steady_clock::now() - _start;
+    if (duration >= _sink->leafThreshold()) {
+      _sink->span(_name, _detail(), _start, duration);
+    }
+  }
+  FBTraceLeafSpan(const FBTraceLeafSpan &) = delete;
+  FBTraceLeafSpan &operator=(const FBTraceLeafSpan &) = delete;
+};
+
+#else
+
+class FBTraceSpan {
+public:
+  explicit FBTraceSpan(const char *name) {}
+};
+
+template <typename Detail> class FBTraceLeafSpan {
+public:
+  FBTraceLeafSpan(const char *name, Detail detail) {}
+};
+
+#endif
+
+} // namespace fb
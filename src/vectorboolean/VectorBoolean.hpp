@@ -27,13 +27,24 @@ OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 #include "FBCommon.hpp"
+#include "FBArena.hpp"
 #include "FBBezierPath.hpp"
 #include "FBBezierContour.hpp"
 #include "FBBezierCurve.hpp"
 #include "FBBezierGraph.hpp"
 #include "FBBezierIntersection.hpp"
 #include "FBBezierIntersectRange.hpp"
+#include "FBBooleanStats.hpp"
+#include "FBBoundsTree.hpp"
+#include "FBConcurrency.hpp"
+#include "FBContourAdjacency.hpp"
 #include "FBContourOverlap.hpp"
 #include "FBCurveLocation.hpp"
 #include "FBEdgeCrossing.hpp"
-#include "FBGeometry.hpp"
\ No newline at end of file
+#include "FBEdgeTable.hpp"
+#include "FBFunctionRef.hpp"
+#include "FBGeometry.hpp"
+#include "FBIntersectionCounters.hpp"
+#include "FBPreparedPath.hpp"
+#include "FBRectilinear.hpp"
+#include "FBTrace.hpp"
\ No newline at end of file
@@ -0,0 +1,102 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "doctest.h"
+#include "utils.hpp"
+#include "vectorboolean/VectorBoolean.hpp"
+
+using namespace fb;
+
+static void checkAllResults(const FBBezierPath &path1, const FBBezierPath &path2) {
+  auto results = path1.allBooleanResults(path2);
+  checkSamePath(results.unionPath, path1.unionWithPath(path2));
+  checkSamePath(results.intersectPath, path1.intersectWithPath(path2));
+  checkSamePath(results.differencePath, path1.differenceWithPath(path2));
+  checkSamePath(results.xorPath, path1.xorWithPath(path2));
+}
+
+TEST_CASE("all boolean results at once are the same as one at a time") {
+  SUBCASE("circle overlapping rectangle") {
+    FBBezierPath path1;
+    FBBezierPath path2;
+    addRectangle(path1, {{50., 50.}, {300., 200.}});
+    addCircle(path2, {355., 240.}, 125.);
+    checkAllResults(path1, path2);
+    checkAllResults(path2, path1);
+  }
+
+  SUBCASE("arc shapes") {
+    FBBezierPath path1;
+    FBBezierPath path2;
+    addArcShape(path1, {{25., 0.}, {50., 100.}});
+    addArcShape(path2, {{0., 25.}, {100., 50.}});
+    checkAllResults(path1, path2);
+  }
+
+  SUBCASE("holes and contours that cross nothing") {
+    FBBezierPath path1;
+    FBBezierPath path2;
+    addRectangle(path1, {{0., 0.}, {100., 100.}});
+    addRectangle(path1, {{25., 25.}, {50., 50.}});
+    addCircle(path2, {50., 50.}, 30.);
+    addCircle(path2, {200., 200.}, 10.);
+    checkAllResults(path1, path2);
+  }
+
+  SUBCASE("rectangles") {
+    FBBezierPath path1;
+    FBBezierPath path2;
+    addRectangle(path1, {{0., 0.}, {100., 100.}});
+    addRectangle(path2, {{50., 50.}, {100., 100.}});
+    checkAllResults(path1, path2);
+  }
+
+  SUBCASE("grids of circles") {
+    FBBezierPath path1;
+    FBBezierPath path2;
+    for (int row = 0; row < 3; row++) {
+      for (int column = 0; column < 3; column++) {
+        addCircle(path1, {column * 20.0 + 6.0, row * 20.0 + 6.0}, 6.);
+        addCircle(path2, {column * 20.0 + 12.0, row * 20.0 + 12.0}, 6.);
+      }
+    }
+    checkAllResults(path1, path2);
+  }
+}
+
+TEST_CASE("xor of shapes that don't cross") {
+  FBBezierPath outer;
+  FBBezierPath inner;
+  addCircle(outer, {50., 50.}, 30.);
+  addCircle(inner, {50., 50.}, 10.);
+
+  // The inner circle becomes a hole, whichever side it's on
+  CHECK_EQ(FBBezierGraph(outer.xorWithPath(inner)).contours().size(), 2);
+  CHECK_EQ(FBBezierGraph(inner.xorWithPath(outer)).contours().size(), 2);
+
+  // Equal shapes cancel out
+  CHECK_EQ(outer.xorWithPath(outer).size(), 0);
+}
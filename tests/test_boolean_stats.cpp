@@ -0,0 +1,131 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "doctest.h"
+#include "utils.hpp"
+#include "vectorboolean/VectorBoolean.hpp"
+
+using namespace fb;
+
+TEST_CASE("boolean stats") {
+  FBBezierPath rectangle;
+  FBBezierPath circle;
+  addRectangle(rectangle, {{0., 0.}, {100., 100.}});
+  addCircle(circle, {100., 50.}, 30.);
+
+  // Collecting stats doesn't change the result
+  FBBooleanStats stats;
+  auto result = rectangle.unionWithPath(circle, &stats);
+  auto expected = rectangle.unionWithPath(circle);
+  REQUIRE_EQ(result.size(), expected.size());
+  for (size_t i = 0; i < result.size(); i++) {
+    CHECK_EQ(result[i].type, expected[i].type);
+  }
+
+  // The circle crosses the right side of the rectangle twice
+  CHECK_EQ(stats.contourCount, 2);
+  CHECK_EQ(stats.edgeCount, 8);
+  CHECK_EQ(stats.crossingCount, 4);
+  CHECK_GT(stats.buildGraphs.count(), 0);
+  CHECK_GT(stats.insertCrossings.count(), 0);
+  CHECK_GT(stats.intersections.count(), 0);
+  CHECK_GT(stats.bezierPath.count(), 0);
+
+  // The stats accumulate
+  rectangle.intersectWithPath(circle, &stats);
+  CHECK_EQ(stats.contourCount, 4);
+  CHECK_EQ(stats.crossingCount, 8);
+
+  // Rectangles are handled by the rectilinear fast path without building any graphs
+  FBBooleanStats rectilinearStats;
+  FBBezierPath square;
+  addRectangle(square, {{50., 50.}, {100., 100.}});
+  rectangle.xorWithPath(square, &rectilinearStats);
+  CHECK_GT(rectilinearStats.rectilinear.count(), 0);
+  CHECK_EQ(rectilinearStats.buildGraphs.count(), 0);
+  CHECK_EQ(rectilinearStats.edgeCount, 0);
+}
+
+#if FB_INTERSECTION_COUNTERS
+TEST_CASE("intersection counters") {
+  FBBezierPath path1;
+  FBBezierPath path2;
+  for (int column = 0; column < 4; column++) {
+    addCircle(path1, {column * 20.0 + 10.0, 10.0}, 8.);
+    addCircle(path2, {column * 20.0 + 14.0, 10.0}, 8.);
+  }
+
+  // Nothing is counted outside of a scope
+  FBIntersectionCounters serialCounters;
+  path1.unionWithPath(path2);
+  CHECK_EQ(serialCounters.pairsTested, 0);
+
+  {
+    FBIntersectionCountersScope scope(&serialCounters);
+    path1.unionWithPath(path2);
+  }
+  CHECK_GT(serialCounters.pairsTested, 0);
+  CHECK_GT(serialCounters.clippingIterations, 0);
+  CHECK_LE(serialCounters.boundingRectRejections + serialCounters.boundsRejections, serialCounters.pairsTested);
+
+  // The work of the other threads is added to the calling thread's counters
+  FBIntersectionCounters parallelCounters;
+  FBSetThreadCount(4);
+  {
+    FBIntersectionCountersScope scope(&parallelCounters);
+    path1.unionWithPath(path2);
+  }
+  FBSetThreadCount(1);
+  CHECK_EQ(parallelCounters.pairsTested, serialCounters.pairsTested);
+  CHECK_EQ(parallelCounters.clippingIterations, serialCounters.clippingIterations);
+  CHECK_EQ(parallelCounters.newtonRefinements, serialCounters.newtonRefinements);
+}
+#endif
+
+#if FB_TRACING
+TEST_CASE("chrome trace") {
+  FBBezierPath rectangle;
+  FBBezierPath circle;
+  addRectangle(rectangle, {{0., 0.}, {100., 100.}});
+  addCircle(circle, {100., 50.}, 30.);
+  addCircle(circle, {20., 20.}, 5.); // crosses nothing, so it's tested for containment
+
+  // A threshold of zero keeps every leaf call
+  FBChromeTraceWriter writer(std::chrono::nanoseconds(0));
+  FBSetTraceSink(&writer);
+  rectangle.differenceWithPath(circle);
+  FBSetTraceSink(nullptr);
+  rectangle.unionWithPath(circle);
+
+  auto json = writer.toJSON();
+  CHECK(json.starts_with("{\"traceEvents\": ["));
+  CHECK_NE(json.find("\"name\": \"differenceWithBezierGraph\""), std::string::npos);
+  CHECK_NE(json.find("\"name\": \"insertCrossings\""), std::string::npos);
+  CHECK_NE(json.find("\"name\": \"intersectionsWithBezierCurve\""), std::string::npos);
+  CHECK_NE(json.find("\"name\": \"containsContour\""), std::string::npos);
+  CHECK_EQ(json.find("\"name\": \"unionWithBezierGraph\""), std::string::npos);
+}
+#endif
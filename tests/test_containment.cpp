@@ -0,0 +1,135 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "doctest.h"
+#include "utils.hpp"
+#include "vectorboolean/VectorBoolean.hpp"
+
+using namespace fb;
+
+// A square with a joint at every integral coordinate along its sides
+static FBBezierPath jointedSquare(int minimum, int maximum) {
+  FBBezierPath path;
+  path.moveTo({double(minimum), double(minimum)});
+  for (int x = minimum + 1; x <= maximum; x++) {
+    path.lineTo({double(x), double(minimum)});
+  }
+  for (int y = minimum + 1; y <= maximum; y++) {
+    path.lineTo({double(maximum), double(y)});
+  }
+  for (int x = maximum - 1; x >= minimum; x--) {
+    path.lineTo({double(x), double(maximum)});
+  }
+  for (int y = maximum - 1; y > minimum; y--) {
+    path.lineTo({double(minimum), double(y)});
+  }
+  path.close();
+  return path;
+}
+
+TEST_CASE("containment is decided when every ray hits a joint") {
+  // 840 is a multiple of 2 through 8, so every ray through the inner square hits a joint of the
+  //  outer one and can't be used to decide whether the outer square contains it.
+  auto outer = jointedSquare(-10, 850);
+  auto inner = FBBezierPath::rect({{0., 0.}, {840., 840.}});
+
+  auto unionPath = outer.unionWithPath(inner);
+  auto bounds = unionPath.bounds();
+  CHECK_EQ(bounds.origin.x, doctest::Approx(-10.));
+  CHECK_EQ(bounds.origin.y, doctest::Approx(-10.));
+  CHECK_EQ(bounds.size.width, doctest::Approx(860.));
+  CHECK_EQ(bounds.size.height, doctest::Approx(860.));
+  CHECK_EQ(FBBezierGraph(unionPath).contours().size(), 1);
+
+  CHECK_EQ(inner.differenceWithPath(outer).size(), 0);
+  CHECK_EQ(FBBezierGraph(outer.differenceWithPath(inner)).contours().size(), 2);
+}
+
+TEST_CASE("axis aligned rays find the same intersections as clipping") {
+  FBBezierGraph graph(FBBezierPath::circle({50., 50.}, 30.));
+  auto contour = graph.contours().front();
+  for (double offset = -29.5; offset < 30.; offset += 3.5) {
+    auto horizontal = std::make_shared<FBBezierCurve>(FBPoint{0., 50. + offset}, FBPoint{100., 50. + offset});
+    auto vertical = std::make_shared<FBBezierCurve>(FBPoint{50. + offset, 0.}, FBPoint{50. + offset, 100.});
+    for (const auto &ray : {horizontal, vertical}) {
+      for (const auto &edge : contour->edges()) {
+        std::vector<FBPoint> clipped, solved;
+        ray->intersectionsWithBezierCurve(edge, nullptr,
+                                          [&](const std::shared_ptr<FBBezierIntersection> &intersection, bool *stop) {
+                                            clipped.push_back(intersection->location());
+                                          });
+        ray->rayIntersectionsWithBezierCurve(
+            edge, nullptr, [&](const std::shared_ptr<FBBezierIntersection> &intersection, bool *stop) {
+              solved.push_back(intersection->location());
+            });
+        REQUIRE_EQ(solved.size(), clipped.size());
+        for (size_t i = 0; i < solved.size(); i++) {
+          CHECK_EQ(solved[i].x, doctest::Approx(clipped[i].x));
+          CHECK_EQ(solved[i].y, doctest::Approx(clipped[i].y));
+        }
+      }
+    }
+  }
+
+  // Rays through the joints of the circle
+  CHECK(contour->containsPoint({50., 50.}));
+  CHECK(contour->containsPoint({25., 50.}));
+  CHECK_FALSE(contour->containsPoint({50., 81.}));
+}
+
+TEST_CASE("axis aligned rays across near quadratic edges") {
+  for (int i = 0; i < 10; i++) {
+    FBBezierPath lens;
+    addQuadraticLens(lens, {3.7 + i, 11.3}, {97.1, 23.9 + 1.3 * i}, {41.9, 83.3 - i}, {58.1, -47.7 + 2.1 * i});
+    FBBezierGraph graph(lens);
+    for (const auto &edge : graph.contours().front()->edges()) {
+      // Horizontal rays between the higher end point and the apex cross the edge twice
+      const auto &data = edge->data();
+      FBFloat controlY = (3.0 * data.controlPoint1.y - data.endPoint1.y) / 2.0;
+      FBFloat apexT = (data.endPoint1.y - controlY) / (data.endPoint1.y - 2.0 * controlY + data.endPoint2.y);
+      FBFloat apexY = edge->locationAtParameter(apexT).y;
+      FBFloat endY = apexY > data.endPoint1.y ? std::max(data.endPoint1.y, data.endPoint2.y)
+                                              : std::min(data.endPoint1.y, data.endPoint2.y);
+      for (int k = 1; k < 8; k++) {
+        FBFloat y = endY + (apexY - endY) * k / 8.0;
+        auto ray = std::make_shared<FBBezierCurve>(FBPoint{-10., y}, FBPoint{110., y});
+        size_t count = 0;
+        ray->rayIntersectionsWithBezierCurve(
+            edge, nullptr, [&](const std::shared_ptr<FBBezierIntersection> &intersection, bool *stop) {
+              CHECK_EQ(intersection->location().y, doctest::Approx(y));
+              ++count;
+            });
+        CHECK_EQ(count, 2);
+      }
+    }
+
+    // A small square inside the lens, level with the top edge's double crossings, which the
+    //  containment rays have to find inside
+    auto square = FBBezierPath::rect({{40. + i, 38.}, {3., 3.}});
+    CHECK_EQ(FBBezierGraph(lens.unionWithPath(square)).contours().size(), 1);
+    CHECK_EQ(FBBezierGraph(lens.intersectWithPath(square)).contours().size(), 1);
+  }
+}
@@ -0,0 +1,67 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "doctest.h"
+#include "utils.hpp"
+#include "vectorboolean/VectorBoolean.hpp"
+
+using namespace fb;
+
+TEST_CASE("identical contours") {
+  FBBezierPath rectangle;
+  FBBezierPath turned;
+  FBBezierPath moved;
+  addRectangle(rectangle, {{10., 10.}, {40., 20.}});
+  // The same rectangle, starting at the opposite corner and going the other way around
+  turned.moveTo({50., 30.});
+  turned.lineTo({50., 10.});
+  turned.lineTo({10., 10.});
+  turned.lineTo({10., 30.});
+  turned.close();
+  addRectangle(moved, {{10., 10.}, {40., 20.000001}});
+
+  auto contour = FBBezierGraph(rectangle).contours().front();
+  auto turnedContour = FBBezierGraph(turned).contours().front();
+  auto movedContour = FBBezierGraph(moved).contours().front();
+  size_t offset = 0;
+  bool reversed = false;
+  CHECK_EQ(contour->fingerprint(), turnedContour->fingerprint());
+  CHECK(contour->isIdentical(*turnedContour, &offset, &reversed));
+  CHECK(reversed);
+  CHECK_FALSE(contour->isIdentical(*movedContour, &offset, &reversed));
+
+  // A layer with a copy of itself: two circles joined by a bar. Its own contours are left as they
+  //  are, since an operand's contours are never merged with each other.
+  FBBezierPath layer;
+  addCircle(layer, {20., 20.}, 10.);
+  addCircle(layer, {50., 20.}, 10.);
+  addRectangle(layer, {{15., 15.}, {40., 10.}});
+  FBBezierPath copy = layer;
+  CHECK_EQ(FBBezierGraph(layer.unionWithPath(copy)).contours().size(), 3);
+  CHECK_EQ(FBBezierGraph(layer.intersectWithPath(copy)).contours().size(), 3);
+  CHECK_EQ(layer.differenceWithPath(copy).size(), 0);
+  CHECK_EQ(layer.xorWithPath(copy).size(), 0);
+}
@@ -0,0 +1,199 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "doctest.h"
+#include "utils.hpp"
+#include "vectorboolean/VectorBoolean.hpp"
+
+using namespace fb;
+
+TEST_CASE("lines against curves") {
+  FBBezierGraph graph(FBBezierPath::circle({50., 50.}, 30.));
+  auto contour = graph.contours().front();
+  for (double angle = 0.05; angle < 3.1; angle += 0.4) {
+    FBPoint direction{std::cos(angle), std::sin(angle)};
+    auto line = std::make_shared<FBBezierCurve>(FBPoint{50. - 45. * direction.x, 50. - 45. * direction.y},
+                                                FBPoint{50. + 45. * direction.x, 50. + 45. * direction.y});
+    size_t count = 0;
+    for (const auto &edge : contour->edges()) {
+      // Both orders have to land on the same points, on both curves
+      std::vector<FBPoint> lineFirst, curveFirst;
+      line->intersectionsWithBezierCurve(edge, nullptr,
+                                         [&](const std::shared_ptr<FBBezierIntersection> &intersection, bool *stop) {
+                                           FBPoint onLine = line->locationAtParameter(intersection->parameter1());
+                                           FBPoint onEdge = edge->locationAtParameter(intersection->parameter2());
+                                           CHECK_EQ(onLine.x, doctest::Approx(onEdge.x));
+                                           CHECK_EQ(onLine.y, doctest::Approx(onEdge.y));
+                                           lineFirst.push_back(intersection->location());
+                                         });
+      edge->intersectionsWithBezierCurve(line, nullptr,
+                                         [&](const std::shared_ptr<FBBezierIntersection> &intersection, bool *stop) {
+                                           curveFirst.push_back(intersection->location());
+                                         });
+      REQUIRE_EQ(lineFirst.size(), curveFirst.size());
+      for (size_t i = 0; i < lineFirst.size(); i++) {
+        CHECK_EQ(lineFirst[i].x, doctest::Approx(curveFirst[i].x));
+        CHECK_EQ(lineFirst[i].y, doctest::Approx(curveFirst[i].y));
+        FBFloat radius = std::hypot(lineFirst[i].x - 50., lineFirst[i].y - 50.);
+        CHECK_EQ(radius, doctest::Approx(30.).epsilon(1e-3));
+      }
+      count += lineFirst.size();
+    }
+    CHECK_EQ(count, 2);
+  }
+
+  // A line ending on the joint between two of the circle's curves meets both at their ends
+  auto line = std::make_shared<FBBezierCurve>(FBPoint{10., 50.}, FBPoint{20., 50.});
+  size_t count = 0;
+  for (const auto &edge : contour->edges()) {
+    line->intersectionsWithBezierCurve(edge, nullptr,
+                                       [&](const std::shared_ptr<FBBezierIntersection> &intersection, bool *stop) {
+                                         CHECK_EQ(intersection->parameter1(), 1.);
+                                         CHECK((intersection->parameter2() == 0. || intersection->parameter2() == 1.));
+                                         ++count;
+                                       });
+  }
+  CHECK_EQ(count, 2);
+}
+
+TEST_CASE("lines crossing elevated quadratics twice") {
+  for (int i = 0; i < 10; i++) {
+    FBBezierPath lens;
+    addQuadraticLens(lens, {3.7 + i, 11.3}, {97.1, 23.9 + 1.3 * i}, {41.9, 83.3 - i}, {58.1, -47.7 + 2.1 * i});
+    FBBezierGraph graph(lens);
+    auto edges = graph.contours().front()->edges();
+    // Slightly slanted lines across each edge's bulge, between its end points and its apex, cross it
+    //  twice
+    for (const auto &[edge, y] : {std::pair{edges[0], 40.}, std::pair{edges[1], -3. + i}}) {
+      for (FBFloat slope : {-0.01, 0.0, 0.013}) {
+        auto line = std::make_shared<FBBezierCurve>(FBPoint{-10., y - 60. * slope}, FBPoint{110., y + 60. * slope});
+        std::vector<FBPoint> lineFirst, curveFirst;
+        line->intersectionsWithBezierCurve(edge, nullptr,
+                                           [&](const std::shared_ptr<FBBezierIntersection> &intersection, bool *stop) {
+                                             FBPoint onLine = line->locationAtParameter(intersection->parameter1());
+                                             FBPoint onEdge = edge->locationAtParameter(intersection->parameter2());
+                                             CHECK_EQ(onLine.x, doctest::Approx(onEdge.x));
+                                             CHECK_EQ(onLine.y, doctest::Approx(onEdge.y));
+                                             lineFirst.push_back(intersection->location());
+                                           });
+        edge->intersectionsWithBezierCurve(line, nullptr,
+                                           [&](const std::shared_ptr<FBBezierIntersection> &intersection, bool *stop) {
+                                             curveFirst.push_back(intersection->location());
+                                           });
+        CHECK_EQ(lineFirst.size(), 2);
+        CHECK_EQ(curveFirst.size(), 2);
+      }
+    }
+
+    // A rectangle whose bottom edge cuts the cap off the lens
+    auto rectangle = FBBezierPath::rect({{-10., 40.}, {120., 30.}});
+    auto intersectPath = lens.intersectWithPath(rectangle);
+    CHECK_EQ(FBBezierGraph(intersectPath).contours().size(), 1);
+    CHECK_EQ(intersectPath.bounds().origin.y, doctest::Approx(40.));
+    auto differencePath = lens.differenceWithPath(rectangle);
+    CHECK_EQ(FBBezierGraph(differencePath).contours().size(), 1);
+    CHECK_EQ(differencePath.bounds().origin.y + differencePath.bounds().size.height, doctest::Approx(40.));
+  }
+}
+
+TEST_CASE("coincident curves share a section") {
+  auto curve = std::make_shared<FBBezierCurve>(FBPoint{0., 0.}, FBPoint{0., 10.}, FBPoint{10., 20.}, FBPoint{20., 20.});
+  auto section = curve->subcurveWithRange({0.25, 0.75});
+  auto reversed = std::make_shared<FBBezierCurve>(section->endPoint2(), section->controlPoint2(),
+                                                  section->controlPoint1(), section->endPoint1());
+  for (const auto &other : {section, reversed}) {
+    std::shared_ptr<FBBezierIntersectRange> range;
+    size_t count = 0;
+    curve->intersectionsWithBezierCurve(
+        other, &range, [&](const std::shared_ptr<FBBezierIntersection> &intersection, bool *stop) { ++count; });
+    CHECK_EQ(count, 0);
+    REQUIRE(range != nullptr);
+    CHECK_EQ(range->parameterRange1().minimum, doctest::Approx(0.25));
+    CHECK_EQ(range->parameterRange1().maximum, doctest::Approx(0.75));
+    CHECK_EQ(range->parameterRange2().minimum, doctest::Approx(0.));
+    CHECK_EQ(range->parameterRange2().maximum, doctest::Approx(1.));
+    CHECK_EQ(range->reversed(), other == reversed);
+  }
+
+  // The same circle, split into twice as many curves
+  FBBezierPath circle;
+  addCircle(circle, {50., 50.}, 30.);
+  FBBezierPath split;
+  FBPoint start = circle[0].points[0];
+  split.moveTo(start);
+  for (size_t i = 1; i < circle.size(); i++) {
+    FBBezierCurve quarter(start, circle[i].points[0], circle[i].points[1], circle[i].points[2]);
+    auto first = quarter.subcurveWithRange({0., 0.5});
+    auto second = quarter.subcurveWithRange({0.5, 1.});
+    split.curveTo(first->endPoint2(), first->controlPoint1(), first->controlPoint2());
+    split.curveTo(second->endPoint2(), second->controlPoint1(), second->controlPoint2());
+    start = circle[i].points[2];
+  }
+  split.close();
+
+  auto unionPath = circle.unionWithPath(split);
+  auto bounds = unionPath.bounds();
+  CHECK_EQ(bounds.origin.x, doctest::Approx(20.));
+  CHECK_EQ(bounds.origin.y, doctest::Approx(20.));
+  CHECK_EQ(bounds.size.width, doctest::Approx(60.));
+  CHECK_EQ(bounds.size.height, doctest::Approx(60.));
+  CHECK_EQ(FBBezierGraph(unionPath).contours().size(), 1);
+}
+
+TEST_CASE("crossings at the same parameter keep the order they were added in") {
+  auto edge = std::make_shared<FBBezierCurve>(FBPoint{0., 0.}, FBPoint{100., 0.});
+  auto makeCrossing = [&](FBFloat parameter, FBFloat x) {
+    auto other = std::make_shared<FBBezierCurve>(FBPoint{x, -10.}, FBPoint{x, 10.});
+    return std::make_shared<FBEdgeCrossing>(std::make_shared<FBBezierIntersection>(edge, parameter, other, 0.5));
+  };
+  // Two crossings where other edges meet at the same point, then one before them
+  auto first = makeCrossing(0.5, 50.);
+  auto second = makeCrossing(0.5, 50.);
+  auto before = makeCrossing(0.25, 25.);
+  edge->addCrossing(first);
+  edge->addCrossing(second);
+  edge->addCrossing(before);
+
+  CHECK_EQ(edge->firstCrossing(), before);
+  CHECK_EQ(edge->nextCrossing(before), first);
+  CHECK_EQ(edge->nextCrossing(first), second);
+  CHECK_EQ(edge->nextCrossing(second), nullptr);
+  CHECK_EQ(edge->previousCrossing(second), first);
+  CHECK_EQ(edge->previousCrossing(first), before);
+  CHECK_EQ(edge->lastCrossing(), second);
+
+  // Removing a crossing leaves the others in order
+  edge->removeCrossing(first);
+  CHECK_EQ(edge->nextCrossing(before), second);
+  CHECK_EQ(edge->previousCrossing(second), before);
+
+  // A crossing added later at the same parameter goes after the ones already there
+  auto third = makeCrossing(0.5, 50.);
+  edge->addCrossing(third);
+  CHECK_EQ(edge->nextCrossing(second), third);
+  CHECK_EQ(edge->lastCrossing(), third);
+  edge->removeAllCrossings();
+}
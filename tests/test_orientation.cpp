@@ -0,0 +1,81 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "doctest.h"
+#include "utils.hpp"
+#include "vectorboolean/VectorBoolean.hpp"
+
+using namespace fb;
+
+TEST_CASE("orientation has the exact sign near a line") {
+  // Points within a few ulps of the line through (12, 12) and (24, 24), where rounding makes the
+  //  naive determinant unreliable. Scaled by 2^53 the coordinates are integers, so 128-bit
+  //  integer arithmetic gives the exact sign to compare against.
+  const double ulp = std::ldexp(1.0, -53);
+  const __int128 scale = __int128(1) << 53;
+  for (int i = 0; i < 64; i++) {
+    for (int j = 0; j < 64; j++) {
+      FBPoint point{0.5 + i * ulp, 0.5 + j * ulp};
+      __int128 pointX = scale / 2 + i, pointY = scale / 2 + j;
+      __int128 lineX = 12 * scale, lineY = 12 * scale, endX = 24 * scale, endY = 24 * scale;
+      __int128 exact = (endX - lineX) * (pointY - lineY) - (endY - lineY) * (pointX - lineX);
+      int exactSign = (exact > 0) - (exact < 0);
+
+      FBFloat orientation = FBOrientation({12., 12.}, {24., 24.}, point);
+      int sign = (orientation > 0) - (orientation < 0);
+      REQUIRE_EQ(sign, exactSign);
+    }
+  }
+}
+
+TEST_CASE("polygon edges through vertices") {
+  // The square's corners lie exactly on the diamond's edges
+  FBBezierPath square = FBBezierPath::rect({{0., 0.}, {10., 10.}});
+  FBBezierPath diamond;
+  diamond.moveTo({5., -5.});
+  diamond.lineTo({15., 5.});
+  diamond.lineTo({5., 15.});
+  diamond.lineTo({-5., 5.});
+  diamond.close();
+
+  auto unionPath = square.unionWithPath(diamond);
+  auto bounds = unionPath.bounds();
+  CHECK_EQ(bounds.origin.x, doctest::Approx(-5.));
+  CHECK_EQ(bounds.origin.y, doctest::Approx(-5.));
+  CHECK_EQ(bounds.size.width, doctest::Approx(20.));
+  CHECK_EQ(bounds.size.height, doctest::Approx(20.));
+  CHECK_EQ(FBBezierGraph(unionPath).contours().size(), 1);
+
+  auto intersectPath = square.intersectWithPath(diamond);
+  bounds = intersectPath.bounds();
+  CHECK_EQ(bounds.origin.x, doctest::Approx(0.));
+  CHECK_EQ(bounds.origin.y, doctest::Approx(0.));
+  CHECK_EQ(bounds.size.width, doctest::Approx(10.));
+  CHECK_EQ(bounds.size.height, doctest::Approx(10.));
+  CHECK_EQ(FBBezierGraph(intersectPath).contours().size(), 1);
+
+  CHECK_EQ(square.differenceWithPath(diamond).size(), 0);
+}
@@ -0,0 +1,74 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "doctest.h"
+#include "utils.hpp"
+#include "vectorboolean/VectorBoolean.hpp"
+
+using namespace fb;
+
+TEST_CASE("prepared paths give the same results as plain paths") {
+  // A mask with a hole, clipped against a row of shapes
+  FBBezierPath mask;
+  addRectangle(mask, {{0., 0.}, {100., 60.}});
+  addCircle(mask, {50., 30.}, 20.);
+  FBPreparedPath preparedMask(mask);
+
+  for (int i = 0; i < 4; i++) {
+    FBBezierPath shape;
+    addCircle(shape, {i * 30.0 + 10.0, 30.0}, 15.);
+    FBPreparedPath preparedShape(shape);
+
+    // The prepared path as the first operand, the second, and both
+    checkSamePath(preparedMask.unionWithPath(shape), mask.unionWithPath(shape));
+    checkSamePath(preparedMask.intersectWithPath(shape), mask.intersectWithPath(shape));
+    checkSamePath(preparedMask.differenceWithPath(shape), mask.differenceWithPath(shape));
+    checkSamePath(preparedMask.xorWithPath(shape), mask.xorWithPath(shape));
+
+    checkSamePath(shape.unionWithPath(preparedMask), shape.unionWithPath(mask));
+    checkSamePath(shape.intersectWithPath(preparedMask), shape.intersectWithPath(mask));
+    checkSamePath(shape.differenceWithPath(preparedMask), shape.differenceWithPath(mask));
+    checkSamePath(shape.xorWithPath(preparedMask), shape.xorWithPath(mask));
+
+    checkSamePath(preparedMask.differenceWithPath(preparedShape), mask.differenceWithPath(shape));
+    checkSamePath(preparedShape.differenceWithPath(preparedMask), shape.differenceWithPath(mask));
+  }
+}
+
+TEST_CASE("prepared paths are not modified by the operations") {
+  FBBezierPath path1;
+  FBBezierPath path2;
+  addArcShape(path1, {{25., 0.}, {50., 100.}});
+  addArcShape(path2, {{0., 25.}, {100., 50.}});
+  FBPreparedPath prepared1(path1);
+
+  auto first = prepared1.intersectWithPath(path2);
+  prepared1.xorWithPath(path2);
+  prepared1.unionWithPath(path2);
+  auto second = prepared1.intersectWithPath(path2);
+  CHECK_GT(first.size(), 0);
+  checkSamePath(first, second);
+}
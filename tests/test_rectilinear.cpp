@@ -0,0 +1,145 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "doctest.h"
+#include "utils.hpp"
+#include "vectorboolean/VectorBoolean.hpp"
+
+using namespace fb;
+
+static FBBezierPath graphOperation(const FBBezierPath &path1, const FBBezierPath &path2,
+                                   FBBooleanOperation operation) {
+  FBOperationArena arena;
+  auto graph1 = FBMakeShared<FBBezierGraph>(path1);
+  auto graph2 = FBMakeShared<FBBezierGraph>(path2);
+  switch (operation) {
+  case FBBooleanOperation::unite:
+    return graph1->unionWithBezierGraph(graph2)->bezierPath();
+  case FBBooleanOperation::intersect:
+    return graph1->intersectWithBezierGraph(graph2)->bezierPath();
+  case FBBooleanOperation::subtract:
+    return graph1->differenceWithBezierGraph(graph2)->bezierPath();
+  case FBBooleanOperation::exclusiveOr:
+    return graph1->xorWithBezierGraph(graph2)->bezierPath();
+  }
+  return FBBezierPath();
+}
+
+// The rectilinear code doesn't round where the edges cross, so the points can differ in the last bits
+static void checkSameContours(const FBBezierPath &path1, const FBBezierPath &path2) {
+  REQUIRE_EQ(path1.size(), path2.size());
+  for (size_t i = 0; i < path1.size(); i++) {
+    CHECK_EQ(path1[i].type, path2[i].type);
+    CHECK_LT(std::abs(path1[i].points[0].x - path2[i].points[0].x), 1e-9);
+    CHECK_LT(std::abs(path1[i].points[0].y - path2[i].points[0].y), 1e-9);
+  }
+}
+
+static void checkAllOperations(const FBBezierPath &path1, const FBBezierPath &path2) {
+  for (auto operation : {FBBooleanOperation::unite, FBBooleanOperation::intersect, FBBooleanOperation::subtract,
+                         FBBooleanOperation::exclusiveOr}) {
+    FBBezierPath result;
+    REQUIRE(FBRectilinearBooleanOperation(path1, path2, operation, result));
+    checkSameContours(result, graphOperation(path1, path2, operation));
+  }
+}
+
+TEST_CASE("rectilinear operations give the same contours as the bezier graph") {
+  // Every way two rectangles can be placed against each other without touching: each side of the
+  //  second one is to the left of, inside or to the right of the first one.
+  const double positions[] = {-5.5, 3.5, 7.5, 15.5};
+  FBBezierPath rect1 = FBBezierPath::rect({{0., 0.}, {10., 10.}});
+  for (int left = 0; left < 4; left++) {
+    for (int right = left + 1; right < 4; right++) {
+      for (int bottom = 0; bottom < 4; bottom++) {
+        for (int top = bottom + 1; top < 4; top++) {
+          FBBezierPath rect2 = FBBezierPath::rect(
+              {{positions[left], positions[bottom]},
+               {positions[right] - positions[left], positions[top] - positions[bottom]}});
+          checkAllOperations(rect1, rect2);
+          checkAllOperations(rect2, rect1);
+        }
+      }
+    }
+  }
+
+  // A comb, going clockwise, cut by a bar into several contours
+  FBBezierPath comb;
+  comb.moveTo({0., 0.});
+  comb.lineTo({0., 20.});
+  comb.lineTo({10., 20.});
+  comb.lineTo({10., 6.});
+  comb.lineTo({20., 6.});
+  comb.lineTo({20., 20.});
+  comb.lineTo({30., 20.});
+  comb.lineTo({30., 0.});
+  comb.close();
+  FBBezierPath bar = FBBezierPath::rect({{-3., 10.}, {40., 5.}});
+  checkAllOperations(comb, bar);
+  checkAllOperations(bar, comb);
+}
+
+TEST_CASE("paths the rectilinear code doesn't handle") {
+  FBBezierPath rect = FBBezierPath::rect({{0., 0.}, {10., 10.}});
+  FBBezierPath result;
+
+  // Edges that overlap or touch
+  CHECK_FALSE(FBRectilinearBooleanOperation(rect, FBBezierPath::rect({{5., 0.}, {10., 10.}}),
+                                            FBBooleanOperation::unite, result));
+  CHECK_FALSE(FBRectilinearBooleanOperation(rect, FBBezierPath::rect({{10., 2.}, {10., 5.}}),
+                                            FBBooleanOperation::unite, result));
+  CHECK_FALSE(FBRectilinearBooleanOperation(rect, FBBezierPath::rect({{5., 10.}, {10., 10.}}),
+                                            FBBooleanOperation::unite, result));
+
+  // Curves, diagonal lines, more than one contour and contours that cross themselves
+  CHECK_FALSE(FBRectilinearBooleanOperation(rect, FBBezierPath::circle({5., 5.}, 3.), FBBooleanOperation::unite,
+                                            result));
+  FBBezierPath triangle;
+  triangle.moveTo({2., 2.});
+  triangle.lineTo({8., 2.});
+  triangle.lineTo({8., 8.});
+  triangle.close();
+  CHECK_FALSE(FBRectilinearBooleanOperation(rect, triangle, FBBooleanOperation::unite, result));
+  FBBezierPath twoRects;
+  addRectangle(twoRects, {{2., 2.}, {1., 1.}});
+  addRectangle(twoRects, {{4., 4.}, {1., 1.}});
+  CHECK_FALSE(FBRectilinearBooleanOperation(rect, twoRects, FBBooleanOperation::unite, result));
+  FBBezierPath bowtie;
+  bowtie.moveTo({2., 2.});
+  bowtie.lineTo({6., 2.});
+  bowtie.lineTo({6., 4.});
+  bowtie.lineTo({4., 4.});
+  bowtie.lineTo({4., 1.});
+  bowtie.lineTo({2., 1.});
+  bowtie.close();
+  CHECK_FALSE(FBRectilinearBooleanOperation(rect, bowtie, FBBooleanOperation::unite, result));
+  CHECK_EQ(result.size(), 0);
+
+  // Which still work, through the bezier graph
+  auto bounds = rect.unionWithPath(FBBezierPath::rect({{5., 0.}, {10., 10.}})).bounds();
+  CHECK_EQ(bounds.origin.x, 0.);
+  CHECK_EQ(bounds.size.width, 15.);
+}
@@ -0,0 +1,62 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "doctest.h"
+#include "utils.hpp"
+#include "vectorboolean/VectorBoolean.hpp"
+
+using namespace fb;
+
+TEST_CASE("results do not depend on the thread count") {
+  FBBezierPath path1;
+  FBBezierPath path2;
+  for (int row = 0; row < 4; row++) {
+    for (int column = 0; column < 4; column++) {
+      addRectangle(path1, {{column * 20.0, row * 20.0}, {12., 12.}});
+      addCircle(path1, {column * 20.0 + 10.0, row * 20.0 + 10.0}, 4.);
+      addCircle(path2, {column * 20.0 + 12.0, row * 20.0 + 12.0}, 6.);
+    }
+  }
+
+  FBSetThreadCount(1);
+  auto serialUnion = path1.unionWithPath(path2);
+  auto serialIntersect = path1.intersectWithPath(path2);
+  auto serialDifference = path1.differenceWithPath(path2);
+  auto serialXor = path1.xorWithPath(path2);
+
+  FBSetThreadCount(4);
+  auto parallelUnion = path1.unionWithPath(path2);
+  auto parallelIntersect = path1.intersectWithPath(path2);
+  auto parallelDifference = path1.differenceWithPath(path2);
+  auto parallelXor = path1.xorWithPath(path2);
+  FBSetThreadCount(1);
+
+  CHECK_GT(serialUnion.size(), 0);
+  checkSamePath(serialUnion, parallelUnion);
+  checkSamePath(serialIntersect, parallelIntersect);
+  checkSamePath(serialDifference, parallelDifference);
+  checkSamePath(serialXor, parallelXor);
+}
@@ -0,0 +1,96 @@
+/*
+Copyright (c) 2011 Andrew Finnell
+Copyright (c) 2025 - Yohei Yoshihara
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the “Software”), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "doctest.h"
+#include "utils.hpp"
+#include "vectorboolean/VectorBoolean.hpp"
+
+#include <vector>
+
+using namespace fb;
+
+static void checkSameRect(const FBRect &rect1, const FBRect &rect2) {
+  CHECK_EQ(rect1.origin.x, doctest::Approx(rect2.origin.x));
+  CHECK_EQ(rect1.origin.y, doctest::Approx(rect2.origin.y));
+  CHECK_EQ(rect1.size.width, doctest::Approx(rect2.size.width));
+  CHECK_EQ(rect1.size.height, doctest::Approx(rect2.size.height));
+}
+
+TEST_CASE("unionAll of overlapping rectangles") {
+  // A row of 7 rectangles, each overlapping the next one
+  std::vector<FBBezierPath> paths;
+  for (int i = 0; i < 7; i++) {
+    paths.push_back(FBBezierPath::rect({{i * 10.0, 0.0}, {15.0, 10.0}}));
+  }
+
+  auto result = FBBezierPath::unionAll(paths);
+  checkSameRect(result.bounds(), {{0.0, 0.0}, {75.0, 10.0}});
+
+  auto folded = paths[0];
+  for (size_t i = 1; i < paths.size(); i++) {
+    folded = folded.unionWithPath(paths[i]);
+  }
+  checkSameRect(result.bounds(), folded.bounds());
+}
+
+TEST_CASE("intersectAll of overlapping rectangles") {
+  std::vector<FBBezierPath> paths;
+  for (int i = 0; i < 5; i++) {
+    paths.push_back(FBBezierPath::rect({{i * 2.0, i * 1.0}, {20.0, 20.0}}));
+  }
+
+  auto result = FBBezierPath::intersectAll(paths);
+  checkSameRect(result.bounds(), {{8.0, 4.0}, {12.0, 16.0}});
+}
+
+TEST_CASE("unionAll and intersectAll of zero and one path") {
+  CHECK_EQ(FBBezierPath::unionAll({}).size(), 0);
+  CHECK_EQ(FBBezierPath::intersectAll({}).size(), 0);
+
+  auto circle = FBBezierPath::circle({10.0, 10.0}, 5.0);
+  checkSamePath(FBBezierPath::unionAll({&circle, 1}), circle);
+  checkSamePath(FBBezierPath::intersectAll({&circle, 1}), circle);
+}
+
+TEST_CASE("unionAll does not depend on the thread count") {
+  std::vector<FBBezierPath> paths;
+  for (int row = 0; row < 3; row++) {
+    for (int column = 0; column < 5; column++) {
+      FBBezierPath path;
+      addCircle(path, {column * 8.0, row * 8.0}, 6.);
+      paths.push_back(path);
+    }
+  }
+
+  FBSetThreadCount(1);
+  auto serialUnion = FBBezierPath::unionAll(paths);
+  FBSetThreadCount(4);
+  auto parallelUnion = FBBezierPath::unionAll(paths);
+  FBSetThreadCount(1);
+
+  CHECK_GT(serialUnion.size(), 0);
+  checkSamePath(serialUnion, parallelUnion);
+}
@@ -25,6 +25,7 @@ OTHER DEALINGS IN THE SOFTWARE.
 */
 
 #include "utils.hpp"
+#include "doctest.h"
 
 void addRectangle(fb::FBBezierPath &path, const fb::FBRect &rect) {
   path.moveTo(rect.origin);
@@ -56,3 +57,26 @@ void addArcShape(fb::FBBezierPath &path, const fb::FBRect &rect) {
                fb::FBPoint{(rect.origin.x + rect.size.width) / 2.0, rect.origin.y + rect.size.height});
   path.close();
 }
+
+void checkSamePath(const fb::FBBezierPath &path1, const fb::FBBezierPath &path2) {
+  REQUIRE_EQ(path1.size(), path2.size());
+  for (size_t i = 0; i < path1.size(); i++) {
+    CHECK_EQ(path1[i].type, path2[i].type);
+    for (size_t j = 0; j < path1[i].points.size(); j++) {
+      CHECK_EQ(path1[i].points[j].x, path2[i].points[j].x);
+      CHECK_EQ(path1[i].points[j].y, path2[i].points[j].y);
+    }
+  }
+}
+
+void addQuadraticLens(fb::FBBezierPath &path, const fb::FBPoint &start, const fb::FBPoint &end,
+                      const fb::FBPoint &controlPoint1, const fb::FBPoint &controlPoint2) {
+  auto elevate = [](const fb::FBPoint &endPoint, const fb::FBPoint &controlPoint) {
+    return fb::FBPoint{endPoint.x + 2.0 / 3.0 * (controlPoint.x - endPoint.x),
+                       endPoint.y + 2.0 / 3.0 * (controlPoint.y - endPoint.y)};
+  };
+  path.moveTo(start);
+  path.curveTo(end, elevate(start, controlPoint1), elevate(end, controlPoint1));
+  path.curveTo(start, elevate(end, controlPoint2), elevate(start, controlPoint2));
+  path.close();
+}
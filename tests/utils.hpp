@@ -32,5 +32,11 @@ OTHER DEALINGS IN THE SOFTWARE.
 void addRectangle(fb::FBBezierPath &path, const fb::FBRect &rect);
 void addCircle(fb::FBBezierPath &path, const fb::FBPoint &center, fb::FBFloat radius);
 void addArcShape(fb::FBBezierPath &path, const fb::FBRect &rect);
+// A lens bounded by two quadratic curves between start and end, one drawn towards each control
+//  point and elevated to a cubic the way TrueType and SVG quadratic segments are
+void addQuadraticLens(fb::FBBezierPath &path, const fb::FBPoint &start, const fb::FBPoint &end,
+                      const fb::FBPoint &controlPoint1, const fb::FBPoint &controlPoint2);
+// Checks that the paths have the same elements with exactly the same points
+void checkSamePath(const fb::FBBezierPath &path1, const fb::FBBezierPath &path2);
 
 #endif
\ No newline at end of file